@@ -0,0 +1,60 @@
+// Rests a deep book on one side, then times a single aggressive order that
+// sweeps all of it. Reports the cost per fill for both taker sides.
+//
+//   deep_sweep_bench [levels] [orders_per_level] [rounds]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cstdlib>
+#include "../include/order_book.hpp"
+
+using namespace trading;
+
+namespace {
+
+double sweep_ns_per_fill(Side taker_side, size_t levels, size_t per_level, int rounds) {
+    const Price base = 10000;
+    const Quantity qty = 10;
+    Side maker_side = taker_side == Side::BUY ? Side::SELL : Side::BUY;
+
+    OrderBook book(1, PriceLadder<Side::BUY>::kDefaultMaxLevels, levels * per_level + 1);
+    double total_ns = 0;
+    size_t total_fills = 0;
+
+    for (int r = 0; r < rounds; ++r) {
+        for (size_t l = 0; l < levels; ++l) {
+            Price p = maker_side == Side::SELL ? base + l : base - l;
+            for (size_t i = 0; i < per_level; ++i) {
+                book.add_order(p, qty, maker_side, [](const Trade&) {});
+            }
+        }
+
+        Price limit = taker_side == Side::BUY ? base + levels : base - levels;
+        Quantity sweep_qty = static_cast<Quantity>(levels * per_level * qty);
+        size_t fills = 0;
+
+        auto start = std::chrono::steady_clock::now();
+        book.add_order(limit, sweep_qty, taker_side, [&fills](const Trade&) { ++fills; });
+        auto elapsed = std::chrono::steady_clock::now() - start;
+
+        total_ns += std::chrono::duration<double, std::nano>(elapsed).count();
+        total_fills += fills;
+    }
+    return total_ns / static_cast<double>(total_fills);
+}
+
+}
+
+int main(int argc, char** argv) {
+    size_t levels = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 500;
+    size_t per_level = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 200;
+    int rounds = argc > 3 ? std::atoi(argv[3]) : 20;
+
+    std::cout << "Deep sweep: " << levels << " levels x " << per_level
+              << " orders, " << rounds << " rounds\n";
+    std::cout << std::fixed << std::setprecision(2)
+              << "  BUY taker  | ns/fill: " << sweep_ns_per_fill(Side::BUY, levels, per_level, rounds) << "\n"
+              << "  SELL taker | ns/fill: " << sweep_ns_per_fill(Side::SELL, levels, per_level, rounds) << "\n";
+    return 0;
+}
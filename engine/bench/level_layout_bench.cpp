@@ -0,0 +1,144 @@
+// Compares the intrusive linked-list PriceLevel with the handle-ring
+// RingPriceLevel: build one level of N orders at scattered pool addresses,
+// cancel some of them (25% by default), then sweep the rest as a taker would.
+//
+//   level_layout_bench [cancel_percent]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <type_traits>
+#include "../include/order_pool.hpp"
+#include "../include/price_level.hpp"
+#include "../include/ring_price_level.hpp"
+
+using namespace trading;
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Timing {
+    double cancel_ns;  // Per cancelled order
+    double sweep_ns;   // Per filled order
+};
+
+// Leave the pool's free list in random address order, as after heavy churn
+void scatter_free_list(OrderPool& pool, size_t count, std::mt19937_64& rng) {
+    std::vector<Order*> orders(count);
+    for (auto& o : orders) o = pool.acquire(0, 0, 1, Side::SELL);
+    std::shuffle(orders.begin(), orders.end(), rng);
+    for (Order* o : orders) pool.release(o);
+}
+
+std::vector<size_t> pick_cancels(size_t count, int cancel_percent, std::mt19937_64& rng) {
+    std::vector<size_t> idx(count);
+    for (size_t i = 0; i < count; ++i) idx[i] = i;
+    std::shuffle(idx.begin(), idx.end(), rng);
+    idx.resize(count * static_cast<size_t>(cancel_percent) / 100);
+    return idx;
+}
+
+template<typename Level, typename Cancel, typename Sweep>
+Timing run(size_t count, int cancel_percent, uint64_t seed, Cancel cancel, Sweep sweep) {
+    std::mt19937_64 rng(seed);
+    OrderPool pool(count * 4);
+    scatter_free_list(pool, count * 4, rng);
+
+    Level level(10000);
+    std::vector<Order*> orders(count);
+    for (size_t i = 0; i < count; ++i) {
+        orders[i] = pool.acquire(i + 1, 10000, 100, Side::SELL);
+        if constexpr (std::is_same<Level, RingPriceLevel>::value) {
+            level.add_order(orders[i], pool);
+        } else {
+            level.add_order(orders[i]);
+        }
+    }
+
+    std::vector<size_t> cancels = pick_cancels(count, cancel_percent, rng);
+    auto t0 = Clock::now();
+    for (size_t i : cancels) cancel(level, pool, orders[i]);
+    auto t1 = Clock::now();
+    size_t filled = sweep(level, pool);
+    auto t2 = Clock::now();
+
+    return Timing{
+        cancels.empty() ? 0.0 : std::chrono::duration<double, std::nano>(t1 - t0).count() / cancels.size(),
+        std::chrono::duration<double, std::nano>(t2 - t1).count() / std::max<size_t>(filled, 1)
+    };
+}
+
+Timing run_list(size_t count, int cancel_percent, uint64_t seed) {
+    return run<PriceLevel>(count, cancel_percent, seed,
+        [](PriceLevel& level, OrderPool& pool, Order* order) {
+            level.remove_order(order);
+            pool.release(order);
+        },
+        [](PriceLevel& level, OrderPool& pool) {
+            size_t filled = 0;
+            while (Order* maker = level.get_head()) {
+                Quantity qty = maker->remaining_quantity();
+                maker->fill(qty);
+                level.update_quantity(qty);
+                level.remove_order(maker);
+                pool.release(maker);
+                ++filled;
+            }
+            return filled;
+        });
+}
+
+Timing run_ring(size_t count, int cancel_percent, uint64_t seed) {
+    return run<RingPriceLevel>(count, cancel_percent, seed,
+        [](RingPriceLevel& level, OrderPool& pool, Order* order) {
+            level.cancel_order(order, pool);
+        },
+        [](RingPriceLevel& level, OrderPool& pool) {
+            size_t filled = 0;
+            while (Order* maker = level.get_head(pool)) {
+                Quantity qty = maker->remaining_quantity();
+                maker->fill(qty);
+                level.update_quantity(qty);
+                level.pop_head();
+                pool.release(maker);
+                ++filled;
+            }
+            return filled;
+        });
+}
+
+}
+
+int main(int argc, char** argv) {
+    int cancel_percent = argc > 1 ? std::atoi(argv[1]) : 25;
+
+    std::cout << "One level, " << cancel_percent << "% cancelled before the sweep (ns per order)\n"
+              << "  orders | list cancel | ring cancel | list sweep | ring sweep\n";
+
+    for (size_t count : {1000, 10000, 100000}) {
+        // Repeat small levels so every row covers about a million orders
+        int rounds = static_cast<int>(std::max<size_t>(1, 1000000 / count));
+        Timing list{0, 0}, ring{0, 0};
+        for (int r = 0; r < rounds; ++r) {
+            Timing l = run_list(count, cancel_percent, r + 1);
+            Timing g = run_ring(count, cancel_percent, r + 1);
+            list.cancel_ns += l.cancel_ns / rounds;
+            list.sweep_ns += l.sweep_ns / rounds;
+            ring.cancel_ns += g.cancel_ns / rounds;
+            ring.sweep_ns += g.sweep_ns / rounds;
+        }
+
+        std::cout << std::fixed << std::setprecision(2)
+                  << "  " << std::setw(6) << count
+                  << " | " << std::setw(11) << list.cancel_ns
+                  << " | " << std::setw(11) << ring.cancel_ns
+                  << " | " << std::setw(10) << list.sweep_ns
+                  << " | " << std::setw(10) << ring.sweep_ns << "\n";
+    }
+    return 0;
+}
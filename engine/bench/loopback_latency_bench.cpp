@@ -0,0 +1,186 @@
+// Round-trip latency of one order over loopback, JSON over HTTP against the
+// binary order-entry protocol. Both listeners run in this process as
+// gateways into one matching thread; each client alternates a resting buy with a sell that fills it,
+// so the book stays flat and every other order produces one trade.
+//
+//   loopback_latency_bench [round_trips] [http_port] [binary_port]
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include "../include/order_book.hpp"
+#include "../include/matching_engine.hpp"
+#include "../include/http_server.hpp"
+#include "../include/binary_server.hpp"
+#include "../include/binary_client.hpp"
+
+using namespace trading;
+
+namespace {
+
+constexpr size_t kWarmup = 2000;
+
+// Minimal keep-alive HTTP client: one request in flight at a time,
+// reconnecting when the server ends the connection
+class HttpClient {
+public:
+    ~HttpClient() {
+        if (fd_ >= 0) close(fd_);
+    }
+
+    bool connect(int port) {
+        if (fd_ >= 0) close(fd_);
+        port_ = port;
+        fd_ = socket(AF_INET, SOCK_STREAM, 0);
+        sockaddr_in address{};
+        address.sin_family = AF_INET;
+        address.sin_port = htons(port);
+        address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        if (::connect(fd_, (sockaddr*)&address, sizeof(address)) != 0) {
+            close(fd_);
+            fd_ = -1;
+            return false;
+        }
+        int opt = 1;
+        setsockopt(fd_, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+        return true;
+    }
+
+    // Returns false unless the reply is a 200
+    bool post(const std::string& path, const std::string& body) {
+        request_ = "POST " + path + " HTTP/1.1\r\nHost: localhost\r\nContent-Type: application/json\r\n"
+                   "Content-Length: " + std::to_string(body.size()) + "\r\n\r\n" + body;
+        if (send(fd_, request_.data(), request_.size(), 0) != static_cast<ssize_t>(request_.size())) return false;
+
+        // Read the head, then exactly Content-Length bytes of body
+        response_.clear();
+        size_t head_end;
+        while ((head_end = response_.find("\r\n\r\n")) == std::string::npos) {
+            if (!receive()) return false;
+        }
+        size_t length_at = response_.find("Content-Length: ");
+        if (length_at == std::string::npos || length_at > head_end) return false;
+        size_t total = head_end + 4 + std::strtoull(response_.c_str() + length_at + 16, nullptr, 10);
+        while (response_.size() < total) {
+            if (!receive()) return false;
+        }
+        if (response_.find("Connection: close") < head_end && !connect(port_)) return false;
+        return response_.compare(0, 12, "HTTP/1.1 200") == 0;
+    }
+
+private:
+    bool receive() {
+        char chunk[4096];
+        ssize_t n = recv(fd_, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        response_.append(chunk, static_cast<size_t>(n));
+        return true;
+    }
+
+    int fd_ = -1;
+    int port_ = 0;
+    std::string request_;
+    std::string response_;
+};
+
+struct Summary {
+    double mean, p50, p90, p99, p999, max;
+};
+
+Summary summarize(std::vector<double>& samples) {
+    std::sort(samples.begin(), samples.end());
+    auto at = [&samples](double q) {
+        return samples[std::min(samples.size() - 1, static_cast<size_t>(q * samples.size()))];
+    };
+    double total = 0;
+    for (double s : samples) total += s;
+    return Summary{total / samples.size(), at(0.50), at(0.90), at(0.99), at(0.999), samples.back()};
+}
+
+void print_row(const char* name, const Summary& s) {
+    std::cout << "  " << std::left << std::setw(8) << name << std::right
+              << " | mean " << std::setw(8) << s.mean
+              << " | p50 " << std::setw(8) << s.p50
+              << " | p90 " << std::setw(8) << s.p90
+              << " | p99 " << std::setw(8) << s.p99
+              << " | p99.9 " << std::setw(8) << s.p999
+              << " | max " << std::setw(9) << s.max << "\n";
+}
+
+template<typename Fn>
+std::vector<double> time_round_trips(size_t count, Fn&& round_trip) {
+    std::vector<double> samples;
+    samples.reserve(count);
+    for (size_t i = 0; i < kWarmup + count; ++i) {
+        auto start = std::chrono::steady_clock::now();
+        if (!round_trip(i)) {
+            std::cerr << "round trip " << i << " failed\n";
+            std::exit(1);
+        }
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        if (i >= kWarmup) samples.push_back(std::chrono::duration<double, std::micro>(elapsed).count());
+    }
+    return samples;
+}
+
+}
+
+int main(int argc, char** argv) {
+    size_t round_trips = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 50000;
+    int http_port = argc > 2 ? std::atoi(argv[2]) : 18080;
+    int binary_port = argc > 3 ? std::atoi(argv[3]) : 18090;
+
+    SymbolDirectory symbols;
+    symbols.add("BENCH", OrderPool::kOrdersPerSlab);
+    MatchingEngine engine(symbols);
+    HttpServer http(http_port, engine.add_gateway());
+    BinaryServer binary(binary_port, engine.add_gateway());
+    engine.start();
+    std::thread http_thread([&http] { http.start(); });
+    std::thread binary_thread([&binary] { binary.start(); });
+
+    HttpClient http_client;
+    BinaryClient binary_client;
+    for (int attempt = 0; attempt < 100 && !(http_client.connect(http_port) && binary_client.connect("127.0.0.1", binary_port)); ++attempt) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+    if (!binary_client.connected()) {
+        std::cerr << "could not connect to the listeners\n";
+        return 1;
+    }
+
+    const std::string buy = "{\"price\":100.00,\"quantity\":1,\"side\":\"BUY\"}";
+    const std::string sell = "{\"price\":100.00,\"quantity\":1,\"side\":\"SELL\"}";
+    std::vector<double> http_samples = time_round_trips(round_trips, [&](size_t i) {
+        return http_client.post("/order", i % 2 == 0 ? buy : sell);
+    });
+
+    wire::ExecutionReport report;
+    std::vector<wire::Fill> fills;
+    std::vector<double> binary_samples = time_round_trips(round_trips, [&](size_t i) {
+        Side side = i % 2 == 0 ? Side::BUY : Side::SELL;
+        return binary_client.new_order(0, BinaryClient::limit(10000, 1, side), report, fills);
+    });
+
+    http.stop();
+    binary.stop();
+    http_thread.join();
+    binary_thread.join();
+    engine.stop();
+
+    std::cout << "Loopback order round trip: " << round_trips << " orders each (us)\n";
+    std::cout << std::fixed << std::setprecision(2);
+    print_row("HTTP", summarize(http_samples));
+    print_row("binary", summarize(binary_samples));
+    return 0;
+}
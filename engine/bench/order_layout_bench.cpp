@@ -0,0 +1,129 @@
+// Sweeps one deep price level with the pre-split Order layout and with the
+// hot/cold split layout, reporting time and cache misses per order visited.
+//
+//   order_layout_bench [orders_per_level] [sweeps]
+
+#include <iostream>
+#include <iomanip>
+#include <vector>
+#include <random>
+#include <numeric>
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include "../include/order_pool.hpp"
+#include "perf_counter.hpp"
+
+using namespace trading;
+
+namespace {
+
+volatile uint64_t g_sink;  // Keeps sweep results observable
+
+// Layout of Order before the hot/cold split
+struct LegacyOrder {
+    OrderId id;
+    Price price;
+    Quantity quantity;
+    Quantity filled_quantity;
+    Side side;
+    OrderStatus status;
+    Timestamp timestamp;
+    LegacyOrder* next;
+    LegacyOrder* prev;
+};
+
+// Link nodes into one FIFO level, either in allocation order or shuffled the
+// way a level looks after heavy churn
+template<typename Node>
+Node* link_level(std::vector<Node*> nodes, bool shuffled, std::mt19937_64& rng) {
+    if (shuffled) std::shuffle(nodes.begin(), nodes.end(), rng);
+    for (size_t i = 0; i < nodes.size(); ++i) {
+        nodes[i]->prev = i > 0 ? nodes[i - 1] : nullptr;
+        nodes[i]->next = i + 1 < nodes.size() ? nodes[i + 1] : nullptr;
+    }
+    return nodes.front();
+}
+
+struct Result {
+    double ns_per_order;
+    double misses_per_order;  // Negative when counters are unavailable
+};
+
+template<typename Node, typename Visit>
+Result sweep(Node* head, size_t count, int sweeps, Visit visit) {
+    PerfCounter misses(PerfCounter::Event::CacheMisses);
+    uint64_t checksum = 0;
+
+    auto start = std::chrono::steady_clock::now();
+    misses.start();
+    for (int s = 0; s < sweeps; ++s) {
+        for (Node* n = head; n != nullptr; n = n->next) {
+            checksum += visit(n);
+        }
+    }
+    long long miss_count = misses.stop();
+    auto elapsed = std::chrono::steady_clock::now() - start;
+
+    g_sink = checksum;
+    double visited = static_cast<double>(count) * sweeps;
+    return Result{
+        std::chrono::duration<double, std::nano>(elapsed).count() / visited,
+        miss_count < 0 ? -1.0 : static_cast<double>(miss_count) / visited
+    };
+}
+
+void report(const char* name, size_t record_bytes, const Result& r) {
+    std::cout << "  " << std::left << std::setw(14) << name
+              << " | bytes/order: " << std::setw(3) << record_bytes
+              << " | ns/order: " << std::fixed << std::setprecision(2) << std::setw(7) << r.ns_per_order
+              << " | cache misses/order: ";
+    if (r.misses_per_order < 0) {
+        std::cout << "n/a";
+    } else {
+        std::cout << std::setprecision(3) << r.misses_per_order;
+    }
+    std::cout << "\n";
+}
+
+}
+
+int main(int argc, char** argv) {
+    size_t count = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 1000000;
+    int sweeps = argc > 2 ? std::atoi(argv[2]) : 10;
+    std::mt19937_64 rng(7);
+
+    std::cout << "Sweeping a level of " << count << " orders, " << sweeps << " times\n";
+
+    std::vector<LegacyOrder> legacy(count);
+    std::vector<LegacyOrder*> legacy_nodes(count);
+    for (size_t i = 0; i < count; ++i) {
+        legacy[i] = LegacyOrder{i + 1, 10000, 100, 0, Side::SELL, OrderStatus::NEW, Timestamp(), nullptr, nullptr};
+        legacy_nodes[i] = &legacy[i];
+    }
+
+    OrderPool pool(count);
+    std::vector<Order*> hot_nodes(count);
+    for (size_t i = 0; i < count; ++i) {
+        hot_nodes[i] = pool.acquire(i + 1, 10000, 100, Side::SELL);
+    }
+
+    for (bool shuffled : {false, true}) {
+        LegacyOrder* legacy_head = link_level(legacy_nodes, shuffled, rng);
+        Order* hot_head = link_level(hot_nodes, shuffled, rng);
+
+        // Each visit reads the maker's quantity and ID the way match_against does
+        Result legacy_result = sweep(legacy_head, count, sweeps, [](LegacyOrder* o) {
+            Quantity remaining = o->quantity - o->filled_quantity;
+            return o->id + remaining;
+        });
+        Result hot_result = sweep(hot_head, count, sweeps, [](Order* o) {
+            return o->id + o->remaining_quantity();
+        });
+
+        std::cout << (shuffled ? "Shuffled queue (after churn):\n" : "Arrival-order queue:\n");
+        report("legacy Order", sizeof(LegacyOrder), legacy_result);
+        report("hot Order", sizeof(Order), hot_result);
+    }
+    return 0;
+}
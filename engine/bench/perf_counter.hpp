@@ -0,0 +1,67 @@
+#pragma once
+// Minimal hardware counter for the benchmarks. Uses perf_event_open on Linux;
+// elsewhere, or when the kernel refuses access, stop() returns -1.
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+    #include <unistd.h>
+    #include <sys/ioctl.h>
+    #include <sys/syscall.h>
+    #include <linux/perf_event.h>
+#endif
+
+class PerfCounter {
+public:
+    enum class Event { CacheMisses, Instructions };
+
+private:
+    int fd_;
+
+public:
+    explicit PerfCounter(Event event) : fd_(-1) {
+#ifdef __linux__
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.config = event == Event::CacheMisses ? PERF_COUNT_HW_CACHE_MISSES : PERF_COUNT_HW_INSTRUCTIONS;
+        attr.disabled = 1;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        fd_ = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+#else
+        (void)event;
+#endif
+    }
+
+    ~PerfCounter() {
+#ifdef __linux__
+        if (fd_ >= 0) close(fd_);
+#endif
+    }
+
+    PerfCounter(const PerfCounter&) = delete;
+    PerfCounter& operator=(const PerfCounter&) = delete;
+
+    void start() {
+#ifdef __linux__
+        if (fd_ < 0) return;
+        ioctl(fd_, PERF_EVENT_IOC_RESET, 0);
+        ioctl(fd_, PERF_EVENT_IOC_ENABLE, 0);
+#endif
+    }
+
+    long long stop() {
+#ifdef __linux__
+        if (fd_ < 0) return -1;
+        ioctl(fd_, PERF_EVENT_IOC_DISABLE, 0);
+        long long value = 0;
+        if (read(fd_, &value, sizeof(value)) != static_cast<ssize_t>(sizeof(value))) return -1;
+        return value;
+#else
+        return -1;
+#endif
+    }
+};
@@ -0,0 +1,125 @@
+// Matching throughput as the engine's symbols are spread over more shards.
+// For each shard count, two producer threads per shard each drive their own
+// gateway, entering batches of crossing orders (a resting buy, then a sell
+// that fills it) round-robin over the symbols of one shard, so the books stay
+// flat and every shard is kept busy. Reports orders matched per second and
+// the speedup over one shard.
+//
+//   shard_scaling_bench [orders_per_producer] [symbols] [max_shards] [first_cpu]
+//
+// With first_cpu set, shard i's matching thread is pinned to first_cpu + i.
+// Scaling is only meaningful with a free core for every matching thread and
+// its producers.
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cstdlib>
+#include "../include/symbol_directory.hpp"
+#include "../include/matching_engine.hpp"
+
+using namespace trading;
+
+namespace {
+
+constexpr size_t kBatch = 32;
+constexpr size_t kProducersPerShard = 2;
+
+double orders_per_second(size_t shards, size_t symbol_count, size_t orders_per_producer, int first_cpu) {
+    SymbolDirectory symbols;
+    for (size_t i = 0; i < symbol_count; ++i) {
+        symbols.add("S" + std::to_string(i));
+    }
+
+    MatchingEngineConfig config;
+    config.shards = shards;
+    config.cpu = first_cpu;
+    MatchingEngine engine(symbols, config);
+
+    size_t producers = shards * kProducersPerShard;
+    std::vector<MatchingEngine::Gateway*> gateways;
+    for (size_t p = 0; p < producers; ++p) {
+        gateways.push_back(&engine.add_gateway());
+    }
+    engine.start();
+
+    std::vector<OrderRequest> batch;
+    for (size_t i = 0; i < kBatch; ++i) {
+        Side side = i % 2 == 0 ? Side::BUY : Side::SELL;
+        batch.push_back(OrderRequest{10000, 1, side, OrderType::LIMIT, TimeInForce::GTC, OrderBook::kUnprotected});
+    }
+
+    std::atomic<size_t> ready{0};
+    std::atomic<bool> go{false};
+    std::vector<std::thread> threads;
+    for (size_t p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            MatchingEngine::Gateway& gateway = *gateways[p];
+            std::vector<SymbolId> mine;
+            for (SymbolId symbol = 0; symbol < symbols.size(); ++symbol) {
+                if (gateway.shard_of(symbol) == p % shards) mine.push_back(symbol);
+            }
+            std::vector<OrderResult> results;
+            ready.fetch_add(1);
+            while (!go.load(std::memory_order_acquire)) std::this_thread::yield();
+
+            for (size_t entered = 0, next = 0; entered < orders_per_producer; entered += kBatch) {
+                gateway.add_orders(mine[next], batch, results);
+                if (++next == mine.size()) next = 0;
+            }
+        });
+    }
+
+    while (ready.load() < producers) std::this_thread::yield();
+    auto start = std::chrono::steady_clock::now();
+    go.store(true, std::memory_order_release);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    engine.stop();
+
+    size_t orders = producers * ((orders_per_producer + kBatch - 1) / kBatch) * kBatch;
+    return orders / std::chrono::duration<double>(elapsed).count();
+}
+
+}
+
+int main(int argc, char** argv) {
+    size_t orders_per_producer = argc > 1 ? std::strtoull(argv[1], nullptr, 10) : 2000000;
+    size_t symbol_count = argc > 2 ? std::strtoull(argv[2], nullptr, 10) : 64;
+    size_t max_shards = argc > 3 ? std::strtoull(argv[3], nullptr, 10)
+                                 : std::max(1u, std::thread::hardware_concurrency() / 2);
+    int first_cpu = argc > 4 ? std::atoi(argv[4]) : -1;
+    max_shards = std::max<size_t>(1, max_shards);
+    if (symbol_count < max_shards) {
+        std::cerr << "need at least one symbol per shard\n";
+        return 1;
+    }
+
+    std::vector<size_t> shard_counts;
+    for (size_t shards = 1; shards < max_shards; shards *= 2) {
+        shard_counts.push_back(shards);
+    }
+    shard_counts.push_back(max_shards);
+
+    std::cout << "Shard scaling: " << symbol_count << " symbols, " << orders_per_producer
+              << " orders per producer in batches of " << kBatch << "\n";
+    std::cout << std::fixed << std::setprecision(2);
+    double baseline = 0;
+    for (size_t shards : shard_counts) {
+        double rate = orders_per_second(shards, symbol_count, orders_per_producer, first_cpu);
+        if (baseline == 0) baseline = rate;
+        std::cout << "  shards " << std::setw(3) << shards
+                  << " | producers " << std::setw(3) << shards * kProducersPerShard
+                  << " | Morders/s " << std::setw(7) << rate / 1e6
+                  << " | speedup " << std::setw(5) << rate / baseline
+                  << " | per shard " << std::setw(5) << rate / baseline / shards << "\n";
+    }
+    return 0;
+}
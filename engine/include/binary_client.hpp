@@ -0,0 +1,64 @@
+#pragma once
+#include <string>
+#include <vector>
+#include "binary_protocol.hpp"
+
+namespace trading {
+
+// Blocking client for the binary order-entry protocol. Each call sends one
+// request and reads until its reply is complete; replies are matched by the
+// client_tag the client assigns. Calls return false on a connection error or
+// a REJECT, whose reason is then in last_reject().
+class BinaryClient {
+public:
+    BinaryClient() = default;
+    ~BinaryClient();
+
+    BinaryClient(const BinaryClient&) = delete;
+    BinaryClient& operator=(const BinaryClient&) = delete;
+
+    bool connect(const std::string& host, int port);
+    void disconnect();
+    bool connected() const { return socket_ >= 0; }
+
+    // Resolve a symbol name to the ID orders carry; report.found says
+    // whether the server knows it. Names longer than 16 bytes are cut.
+    bool lookup_symbol(const std::string& name, wire::SymbolReport& report);
+
+    bool new_order(uint32_t symbol, const wire::OrderEntry& order, wire::ExecutionReport& report,
+                   std::vector<wire::Fill>& fills);
+
+    // One report per entry, in order; `fills` holds all of them in the order
+    // reported, report i's fill_count belonging to it
+    bool new_order_batch(uint32_t symbol, const std::vector<wire::OrderEntry>& orders,
+                         std::vector<wire::ExecutionReport>& reports, std::vector<wire::Fill>& fills);
+
+    bool cancel(OrderId order_id, wire::CancelReport& report);
+
+    bool amend(OrderId order_id, Price price, Quantity quantity,
+               wire::AmendReport& report, std::vector<wire::Fill>& fills);
+
+    wire::RejectReason last_reject() const { return last_reject_; }
+
+    static wire::OrderEntry limit(Price price, Quantity quantity, Side side, TimeInForce tif = TimeInForce::GTC);
+    static wire::OrderEntry market(Quantity quantity, Side side, uint32_t protection_ticks = UINT32_MAX);
+
+private:
+    bool send_all(const std::string& data);
+    // Next whole message into message_; false on EOF or error
+    bool receive_message();
+    // Read messages until one of `type` at least `size` bytes long arrives,
+    // or a REJECT
+    bool expect(wire::MessageType type, size_t size);
+    bool read_fills(uint32_t count, std::vector<wire::Fill>& fills);
+
+    int socket_ = -1;
+    uint64_t next_tag_ = 1;
+    wire::RejectReason last_reject_ = wire::RejectReason::NONE;
+    std::string request_;
+    std::string buffer_;       // Received, not yet consumed
+    size_t buffer_offset_ = 0;
+    std::string message_;      // Current message
+};
+
+}
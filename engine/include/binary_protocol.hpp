@@ -0,0 +1,219 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include "order.hpp"
+
+namespace trading {
+
+// Compact order-entry protocol for the binary listener. Every message is a
+// packed, fixed-layout struct that starts with a MessageHeader giving its
+// total length, so a stream is framed by the length prefix alone. Fields are
+// little-endian (the host order on every platform the engine runs on) and
+// decoding a message is a single copy into the matching struct.
+//
+// Requests carry a client_tag the server echoes on every reply to them.
+// NEW_ORDER and each entry of NEW_ORDER_BATCH are answered by an
+// EXECUTION_REPORT followed by fill_count FILL messages; AMEND by an
+// AMEND_REPORT and its FILLs; CANCEL by a CANCEL_REPORT. Orders name their
+// instrument by symbol ID, which a client resolves once per name with
+// SYMBOL_LOOKUP (answered by a SYMBOL_REPORT); cancels and amends need no
+// symbol since order IDs are engine-wide. Input for a symbol whose input
+// journal has failed is refused with ENGINE_HALTED, on a REJECT for a
+// CANCEL and on the usual report otherwise. A message of another protocol
+// version, of an unknown type or of the wrong size gets a REJECT and the
+// session carries on;
+// a header whose length is unusable closes the connection.
+
+namespace wire {
+
+constexpr uint8_t kVersion = 2;  // 2: symbol IDs on orders, SYMBOL_LOOKUP
+constexpr size_t kMaxBatchOrders = 1000;
+constexpr Price kMaxPrice = 100000000;     // $1,000,000 in cents
+constexpr Quantity kMaxQuantity = 1000000;
+
+enum class MessageType : uint8_t {
+    // Client -> server
+    NEW_ORDER = 1,
+    CANCEL = 2,
+    AMEND = 3,
+    NEW_ORDER_BATCH = 4,
+    SYMBOL_LOOKUP = 5,
+    // Server -> client
+    EXECUTION_REPORT = 101,
+    FILL = 102,
+    CANCEL_REPORT = 103,
+    AMEND_REPORT = 104,
+    REJECT = 105,
+    SYMBOL_REPORT = 106
+};
+
+enum class RejectReason : uint8_t {
+    NONE = 0,
+    INVALID_PRICE = 1,
+    INVALID_QUANTITY = 2,
+    INVALID_SIDE = 3,
+    INVALID_TYPE = 4,
+    INVALID_TIME_IN_FORCE = 5,
+    INVALID_PROTECTION = 6,
+    BOOK_REJECTED = 7,     // Off the price ladder, or a FOK that cannot fill
+    UNKNOWN_MESSAGE = 8,
+    MALFORMED_MESSAGE = 9,
+    BATCH_TOO_LARGE = 10,
+    UNKNOWN_SYMBOL = 11,
+    ENGINE_HALTED = 12,    // The symbol's input journal failed; no input is taken
+    UNSUPPORTED_VERSION = 13  // Header version is not kVersion
+};
+
+#pragma pack(push, 1)
+
+struct MessageHeader {
+    uint16_t length;       // Whole message, header included
+    MessageType type;
+    uint8_t version;
+};
+
+// One order as sent alone or inside a batch. side, type and time_in_force
+// use the numeric values of Side, OrderType and TimeInForce.
+struct OrderEntry {
+    Price price;                // Cents; ignored for MARKET
+    Quantity quantity;
+    uint32_t protection_ticks;  // MARKET only; UINT32_MAX for none
+    uint8_t side;
+    uint8_t type;
+    uint8_t time_in_force;      // MARKET takes IOC only
+    uint8_t reserved;
+};
+
+struct NewOrder {
+    MessageHeader header;
+    uint64_t client_tag;
+    uint32_t symbol;       // SymbolId
+    OrderEntry order;
+};
+
+struct Cancel {
+    MessageHeader header;
+    uint64_t client_tag;
+    OrderId order_id;
+};
+
+struct Amend {
+    MessageHeader header;
+    uint64_t client_tag;
+    OrderId order_id;
+    Price price;
+    Quantity quantity;
+};
+
+// Followed by `count` OrderEntry structs, all for one symbol
+struct NewOrderBatch {
+    MessageHeader header;
+    uint64_t client_tag;
+    uint32_t symbol;       // SymbolId
+    uint16_t count;
+    uint16_t reserved;
+};
+
+struct SymbolLookup {
+    MessageHeader header;
+    uint64_t client_tag;
+    char name[16];         // NUL-padded, not terminated when all 16 are used
+};
+
+struct ExecutionReport {
+    MessageHeader header;
+    uint64_t client_tag;
+    OrderId order_id;      // 0 when rejected
+    Quantity filled_quantity;
+    Quantity resting_quantity;
+    uint32_t fill_count;   // FILL messages that follow
+    uint8_t status;        // OrderStatus
+    RejectReason reason;
+    uint8_t reserved[2];
+};
+
+struct Fill {
+    MessageHeader header;
+    uint64_t client_tag;
+    OrderId buyer_id;
+    OrderId seller_id;
+    Price price;
+    Quantity quantity;
+};
+
+struct CancelReport {
+    MessageHeader header;
+    uint64_t client_tag;
+    OrderId order_id;
+    uint8_t cancelled;     // 0 when the order was not resting
+    uint8_t reserved[3];
+};
+
+struct AmendReport {
+    MessageHeader header;
+    uint64_t client_tag;
+    OrderId order_id;
+    uint32_t fill_count;
+    uint8_t amended;       // 0 when the order was not resting
+    RejectReason reason;
+    uint8_t reserved[2];
+};
+
+struct Reject {
+    MessageHeader header;
+    uint64_t client_tag;   // 0 if the message was too short to carry one
+    MessageType rejected_type;
+    RejectReason reason;
+    uint8_t reserved[2];
+};
+
+struct SymbolReport {
+    MessageHeader header;
+    uint64_t client_tag;
+    uint32_t symbol;       // Valid only when found
+    uint8_t found;
+    uint8_t reserved[3];
+};
+
+#pragma pack(pop)
+
+static_assert(sizeof(MessageHeader) == 4, "wire layout");
+static_assert(sizeof(OrderEntry) == 20, "wire layout");
+static_assert(sizeof(NewOrder) == 36, "wire layout");
+static_assert(sizeof(Cancel) == 20, "wire layout");
+static_assert(sizeof(Amend) == 32, "wire layout");
+static_assert(sizeof(NewOrderBatch) == 20, "wire layout");
+static_assert(sizeof(SymbolLookup) == 28, "wire layout");
+static_assert(sizeof(ExecutionReport) == 36, "wire layout");
+static_assert(sizeof(Fill) == 40, "wire layout");
+static_assert(sizeof(CancelReport) == 24, "wire layout");
+static_assert(sizeof(AmendReport) == 28, "wire layout");
+static_assert(sizeof(Reject) == 16, "wire layout");
+static_assert(sizeof(SymbolReport) == 20, "wire layout");
+static_assert(sizeof(NewOrderBatch) + kMaxBatchOrders * sizeof(OrderEntry) <= UINT16_MAX,
+              "a full batch must fit the length prefix");
+
+template<typename Message>
+constexpr MessageHeader header_for(MessageType type, size_t extra = 0) {
+    return MessageHeader{static_cast<uint16_t>(sizeof(Message) + extra), type, kVersion};
+}
+
+// Messages are packed and may sit at any offset in a buffer, so they are
+// copied in and out rather than dereferenced in place
+template<typename Message>
+Message read_message(const char* data) {
+    Message message;
+    std::memcpy(&message, data, sizeof(Message));
+    return message;
+}
+
+template<typename Message>
+void append_message(std::string& out, const Message& message) {
+    out.append(reinterpret_cast<const char*>(&message), sizeof(Message));
+}
+
+}
+
+}
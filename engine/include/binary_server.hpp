@@ -0,0 +1,77 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <atomic>
+#include <unordered_map>
+#include "matching_engine.hpp"
+#include "binary_protocol.hpp"
+
+namespace trading {
+
+struct BinaryServerConfig {
+    int backlog = 1024;  // Pending connections the kernel queues for accept
+};
+
+// One order-entry session: bytes not yet framed into a message, and replies
+// not yet sent. While replies back up, further requests are left in the
+// kernel (`input_paused`).
+struct BinaryConnection {
+    std::string in;
+    std::string out;
+    size_t out_offset = 0;
+    bool peer_closed = false;
+    bool input_paused = false;
+};
+
+// Listener for the binary order-entry protocol in binary_protocol.hpp. Runs
+// its own edge-triggered epoll loop (call start() on a dedicated thread) and
+// is one more gateway into the MatchingEngine that HttpServer feeds.
+class BinaryServer {
+public:
+    static constexpr size_t kMaxPendingOutput = 1 << 20;  // Stop reading requests until a slow reader catches up
+    static constexpr size_t kMaxBufferedInput = 1 << 20;  // Read-ahead cap; far above any one message
+
+private:
+    int port_;
+    int server_socket_;
+    int epoll_fd_;
+    std::atomic<bool> running_;
+    MatchingEngine::Gateway& engine_;
+    BinaryServerConfig config_;
+    std::unordered_map<int, BinaryConnection> connections_;
+
+    // Scratch reused across messages so the hot path doesn't allocate
+    std::vector<OrderRequest> requests_;
+    std::vector<OrderResult> results_;
+    std::vector<wire::RejectReason> reasons_;
+
+public:
+    BinaryServer(int port, MatchingEngine::Gateway& engine, const BinaryServerConfig& config = BinaryServerConfig());
+    ~BinaryServer();
+
+    // Blocks until stop()
+    void start();
+    void stop();
+
+private:
+    void run_event_loop();
+    void accept_connections();
+    bool on_readable(int fd, BinaryConnection& conn);
+    bool read_input(int fd, BinaryConnection& conn);
+    bool serve(int fd, BinaryConnection& conn);
+    bool process_messages(BinaryConnection& conn);
+    bool flush(int fd, BinaryConnection& conn);
+    void close_connection(int fd);
+
+    void handle_new_order(const char* data, size_t length, std::string& out);
+    void handle_new_order_batch(const char* data, size_t length, std::string& out);
+    void handle_cancel(const char* data, size_t length, std::string& out);
+    void handle_amend(const char* data, size_t length, std::string& out);
+    void handle_symbol_lookup(const char* data, size_t length, std::string& out);
+
+    // Validate entries into requests_/reasons_, match the valid ones and
+    // write a report plus fills per entry
+    void enter_orders(uint64_t client_tag, SymbolId symbol, const char* entries, size_t count, std::string& out);
+};
+
+}
@@ -0,0 +1,88 @@
+#pragma once
+#include <string_view>
+#include <cstddef>
+#include <cstdint>
+
+namespace trading {
+
+struct HttpHeader {
+    std::string_view name;
+    std::string_view value;
+};
+
+// A parsed request. Every view points into the connection's input buffer and
+// is only valid until that buffer is next modified.
+struct HttpRequest {
+    static constexpr size_t kMaxHeaders = 32;
+
+    std::string_view method;
+    std::string_view path;
+    std::string_view version;
+    std::string_view body;
+    HttpHeader headers[kMaxHeaders];
+    size_t header_count = 0;
+    bool keep_alive = false;  // HTTP/1.1 unless "Connection: close", or opted in on 1.0
+
+    // Case-insensitive lookup; empty if the header is absent
+    std::string_view header(std::string_view name) const;
+};
+
+// Incremental HTTP/1.x request parser. It is fed the unconsumed front of a
+// connection's buffer each time more bytes arrive and picks up where it left
+// off: the header terminator is never searched for twice, and once the
+// headers are in only Content-Length is compared against the buffer size.
+// Positions are kept as offsets, so the buffer may grow or move between
+// calls. Parsing never allocates.
+class HttpParser {
+public:
+    enum class Status { COMPLETE, INCOMPLETE, ERROR };
+
+    static constexpr size_t kMaxHeaderBytes = 8 * 1024;
+
+    explicit HttpParser(size_t max_body_bytes = 1 << 20);
+
+    // Parse the request at the front of [data, data + size). On COMPLETE the
+    // views in `request` point into data and request_length() bytes belong
+    // to it; call reset() before parsing the next request.
+    Status parse(const char* data, size_t size, HttpRequest& request);
+
+    size_t request_length() const {
+        return header_length_ + content_length_;
+    }
+
+    // HTTP status and JSON body describing why parse() returned ERROR
+    int error_status() const {
+        return error_status_;
+    }
+
+    const char* error_body() const {
+        return error_status_ == 413 ? too_large_body_ : error_body_;
+    }
+
+    void reset() {
+        scanned_ = 0;
+        header_length_ = 0;
+        content_length_ = 0;
+        error_status_ = 0;
+        error_body_ = "";
+    }
+
+private:
+    Status fail(int status, const char* body) {
+        error_status_ = status;
+        error_body_ = body;
+        return Status::ERROR;
+    }
+
+    Status parse_head(const char* data, HttpRequest& request);
+
+    size_t max_body_bytes_;
+    size_t scanned_;         // Bytes already searched for the blank line
+    size_t header_length_;   // Request line plus headers plus blank line; 0 until seen
+    size_t content_length_;
+    int error_status_;
+    const char* error_body_;
+    char too_large_body_[64];  // The 413 body, naming max_body_bytes_
+};
+
+}
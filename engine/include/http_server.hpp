@@ -1,33 +1,69 @@
 #pragma once 
 #include <string>
+#include <string_view>
 #include <functional>
-#include "order_book.hpp"
+#include <unordered_map>
+#include <chrono>
+#include <utility>
+#include <atomic>
+#include "matching_engine.hpp"
+#include "http_parser.hpp"
 
 namespace trading {
 
-struct HttpRequest {
-    std::string method;
-    std::string path;
-    std::string body;
-};
-
 struct HttpResponse {
     int status_code;
     std::string body;
     
-    HttpResponse(int code, const std::string& body_)
-        : status_code(code), body(body_) {}
+    HttpResponse(int code, std::string body_)
+        : status_code(code), body(std::move(body_)) {}
+};
+
+struct HttpServerConfig {
+    int backlog = 1024;                      // Pending connections the kernel queues for accept
+    int idle_timeout_ms = 30000;             // Close keep-alive connections quiet for this long
+    size_t max_requests_per_connection = 10000;
+    bool reuse_port = false;                 // Let several event loops share the port (SO_REUSEPORT)
+};
+
+// One client socket in the event loop, with its unparsed input and its
+// unsent output. Pipelined requests queue up in `in` and their responses
+// are appended to `out` in the same order. While the client is slow to read
+// its responses, further requests are left in the kernel (`input_paused`). The newest response body is held
+// in `body` rather than copied behind its headers, so the two go out in one
+// gathered write; `out_offset` counts bytes sent across both.
+struct HttpConnection {
+    HttpParser parser;  // Progress on the request at the front of `in`
+    std::string in;
+    std::string out;
+    std::string body;
+    size_t out_offset = 0;
+    size_t requests_served = 0;
+    std::chrono::steady_clock::time_point last_active;
+    bool close_after_write = false;
+    bool peer_closed = false;
+    bool input_paused = false;
+
+    size_t pending_output() const { return out.size() + body.size() - out_offset; }
 };
 
 class HttpServer {
+public:
+    static constexpr size_t kMaxBatchOrders = 1000;     // Per POST /orders
+    static constexpr size_t kMaxPendingOutput = 1 << 20; // Stop parsing until a slow reader catches up
+    static constexpr size_t kMaxBufferedInput = 2 << 20; // Read-ahead cap; above any single request
+
 private:
     int port_;
     int server_socket_;
-    bool running_;
-    OrderBook& order_book_;
+    int epoll_fd_;
+    std::atomic<bool> running_;
+    MatchingEngine::Gateway& engine_;  // This event loop's line to the matching thread
+    HttpServerConfig config_;
+    std::unordered_map<int, HttpConnection> connections_;
     
 public:
-    HttpServer(int port, OrderBook& book);
+    HttpServer(int port, MatchingEngine::Gateway& engine, const HttpServerConfig& config = HttpServerConfig());
     ~HttpServer();
     
     void start();
@@ -35,16 +71,30 @@ public:
     
 private:
     void handle_connection(int client_socket);
-    HttpRequest parse_request(const std::string& request_str);
+    void run_event_loop();
+    void accept_connections();
+    bool on_readable(int fd, HttpConnection& conn);
+    bool read_input(int fd, HttpConnection& conn);
+    bool serve(int fd, HttpConnection& conn);
+    void process_requests(HttpConnection& conn);
+    bool flush(int fd, HttpConnection& conn);
+    void close_idle_connections();
+    void close_connection(int fd);
     HttpResponse route_request(const HttpRequest& request);
     
-    HttpResponse handle_place_order(const std::string& body);
-    HttpResponse handle_cancel_order(const std::string& body);
-    HttpResponse handle_get_orderbook();
-    HttpResponse handle_get_stats();
+    HttpResponse handle_place_order(std::string_view body);
+    HttpResponse handle_place_orders(std::string_view body);
+    HttpResponse handle_cancel_order(std::string_view body);
+    HttpResponse handle_amend_order(std::string_view body);
+    HttpResponse handle_get_orderbook(std::string_view target);
+    HttpResponse handle_get_stats(std::string_view target);
+    HttpResponse handle_get_engine_stats();
+    HttpResponse handle_get_symbols();
+    HttpResponse handle_get_trades(const std::string& target);
+    HttpResponse handle_set_log_level(std::string_view body);
     HttpResponse handle_health_check();
     
-    std::string build_response(const HttpResponse& response);
+    void write_response(HttpConnection& conn, HttpResponse&& response, bool keep_alive);
 };
 
 }
\ No newline at end of file
@@ -0,0 +1,68 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include "order.hpp"
+
+namespace trading {
+
+// One journaled input: an order, cancel or amend as it entered the engine.
+// A batch of orders is one record per order, all carrying the batch's
+// sequence. Fixed size and packed so the file is a flat array of records.
+#pragma pack(push, 1)
+struct InputRecord {
+    enum class Type : uint8_t { ORDER = 1, CANCEL = 2, AMEND = 3 };
+
+    int64_t sequence;           // Engine sequence the input was matched at
+    OrderId order_id;           // CANCEL, AMEND; the book's own ID
+    Price price;
+    Quantity quantity;
+    uint32_t protection_ticks;  // Market orders
+    uint32_t symbol;            // SymbolId
+    Type type;
+    Side side;
+    OrderType order_type;
+    TimeInForce tif;
+};
+#pragma pack(pop)
+
+static_assert(sizeof(InputRecord) == 40, "InputRecord layout is part of the journal file format");
+
+// Append-only log of every input the matching engine applied, in matching
+// order, so a session can be audited or replayed into a fresh book. Records
+// are buffered and written with one system call per flush().
+class InputJournal {
+private:
+    std::string path_;
+    int fd_;
+    std::vector<InputRecord> pending_;
+    uint64_t written_;
+
+public:
+    InputJournal();
+    ~InputJournal();
+
+    InputJournal(const InputJournal&) = delete;
+    InputJournal& operator=(const InputJournal&) = delete;
+
+    // Start journaling to `path`, truncating any previous contents
+    bool open(const std::string& path);
+    bool is_open() const { return fd_ >= 0; }
+    const std::string& path() const { return path_; }
+
+    void append(const InputRecord& record) {
+        if (fd_ >= 0) pending_.push_back(record);
+    }
+
+    // Write out every appended record. On a write error the journal closes
+    // itself and returns false; later appends are discarded.
+    bool flush();
+
+    uint64_t records_written() const { return written_; }
+
+private:
+    void close();
+};
+
+}
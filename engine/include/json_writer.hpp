@@ -0,0 +1,171 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cstdint>
+#include <cstddef>
+#include <cmath>
+#include <type_traits>
+#include "order.hpp"
+
+namespace trading {
+
+// Appends JSON straight to a caller-owned buffer, for responses on the hot
+// path that would otherwise go through a json DOM and dump(). Commas are
+// inserted automatically; the caller is responsible for balanced begin/end
+// calls and for emitting object keys in the order it wants them (handlers
+// keep nlohmann's sorted order so output is unchanged).
+//
+// Numbers are written with std::to_chars. Doubles use the shortest
+// round-trip form with ".0" appended to integral values, as nlohmann does;
+// prices in cents are written as exact dollar decimals in that same form.
+class JsonWriter {
+public:
+    static constexpr int kMaxDepth = 16;
+
+    explicit JsonWriter(std::string& out)
+        : out_(out), depth_(0)
+    {
+        first_[0] = true;
+    }
+
+    JsonWriter& begin_object() { open('{'); return *this; }
+    JsonWriter& end_object() { close('}'); return *this; }
+    JsonWriter& begin_array() { open('['); return *this; }
+    JsonWriter& end_array() { close(']'); return *this; }
+
+    // Keys are trusted literals and are not escaped
+    JsonWriter& key(std::string_view name) {
+        separate();
+        out_.push_back('"');
+        out_.append(name);
+        out_.append("\":", 2);
+        after_key_ = true;
+        return *this;
+    }
+
+    JsonWriter& value(std::string_view s) {
+        separate();
+        out_.push_back('"');
+        for (char c : s) {
+            switch (c) {
+                case '"': out_.append("\\\"", 2); break;
+                case '\\': out_.append("\\\\", 2); break;
+                case '\n': out_.append("\\n", 2); break;
+                case '\r': out_.append("\\r", 2); break;
+                case '\t': out_.append("\\t", 2); break;
+                default:
+                    if (static_cast<unsigned char>(c) < 0x20) {
+                        char escaped[7] = {'\\', 'u', '0', '0', hex(c >> 4), hex(c & 0xF), 0};
+                        out_.append(escaped, 6);
+                    } else {
+                        out_.push_back(c);
+                    }
+            }
+        }
+        out_.push_back('"');
+        return *this;
+    }
+
+    JsonWriter& value(const char* s) { return value(std::string_view(s)); }
+    JsonWriter& value(const std::string& s) { return value(std::string_view(s)); }
+
+    JsonWriter& value(bool b) {
+        separate();
+        out_.append(b ? "true" : "false");
+        return *this;
+    }
+
+    template<typename T, typename = std::enable_if_t<std::is_integral_v<T> && !std::is_same_v<T, bool>>>
+    JsonWriter& value(T n) {
+        separate();
+        append_integer(n);
+        return *this;
+    }
+
+    JsonWriter& value(double d) {
+        separate();
+        if (!std::isfinite(d)) {
+            out_.append("null", 4);  // As json::dump() does
+            return *this;
+        }
+        // Plain notation across the range json::dump() prints that way
+        double magnitude = std::fabs(d);
+        bool fixed = magnitude == 0.0 || (magnitude >= 1e-4 && magnitude < 1e15);
+        char buf[64];
+        char* end = fixed ? std::to_chars(buf, buf + sizeof(buf), d, std::chars_format::fixed).ptr
+                          : std::to_chars(buf, buf + sizeof(buf), d).ptr;
+        std::string_view text(buf, static_cast<size_t>(end - buf));
+        out_.append(text);
+        if (text.find_first_of(".e") == std::string_view::npos) out_.append(".0", 2);
+        return *this;
+    }
+
+    // Cents as dollars: 10005 -> 100.05, 10050 -> 100.5, 10000 -> 100.0
+    JsonWriter& price(Price cents) {
+        separate();
+        append_integer(cents / 100);
+        unsigned fraction = static_cast<unsigned>(cents % 100);
+        out_.push_back('.');
+        out_.push_back(static_cast<char>('0' + fraction / 10));
+        if (fraction % 10 != 0) out_.push_back(static_cast<char>('0' + fraction % 10));
+        return *this;
+    }
+
+    JsonWriter& null() {
+        separate();
+        out_.append("null", 4);
+        return *this;
+    }
+
+    // Paste an already-serialized JSON value
+    JsonWriter& raw(std::string_view json) {
+        separate();
+        out_.append(json);
+        return *this;
+    }
+
+    template<typename T>
+    JsonWriter& field(std::string_view name, const T& v) {
+        return key(name).value(v);
+    }
+
+private:
+    static char hex(int v) {
+        return static_cast<char>(v < 10 ? '0' + v : 'a' + v - 10);
+    }
+
+    template<typename T>
+    void append_integer(T n) {
+        char buf[24];
+        char* end = std::to_chars(buf, buf + sizeof(buf), n).ptr;
+        out_.append(buf, static_cast<size_t>(end - buf));
+    }
+
+    void separate() {
+        if (after_key_) {
+            after_key_ = false;
+            return;
+        }
+        if (!first_[depth_]) out_.push_back(',');
+        first_[depth_] = false;
+    }
+
+    void open(char c) {
+        separate();
+        out_.push_back(c);
+        first_[++depth_] = true;
+    }
+
+    void close(char c) {
+        out_.push_back(c);
+        --depth_;
+    }
+
+    std::string& out_;
+    int depth_;
+    bool first_[kMaxDepth + 1];
+    bool after_key_ = false;
+};
+
+}
@@ -0,0 +1,241 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <type_traits>
+
+// Calls below this level are compiled out entirely (0 = DEBUG ... 4 = OFF)
+#ifndef ENGINE_LOG_COMPILE_LEVEL
+#define ENGINE_LOG_COMPILE_LEVEL 0
+#endif
+
+namespace trading {
+
+enum class LogLevel : uint8_t {
+    DEBUG = 0,
+    INFO = 1,
+    WARN = 2,
+    ERROR = 3,
+    OFF = 4
+};
+
+const char* log_level_to_string(LogLevel level);
+bool parse_log_level(std::string_view name, LogLevel& level);
+
+// Single-producer single-consumer byte ring holding encoded log records. Each
+// logging thread owns one; the logger's writer thread is the only reader.
+class LogRing {
+public:
+    explicit LogRing(size_t capacity);
+
+    // Reserve `size` contiguous bytes, or nullptr if the ring is full
+    unsigned char* reserve(size_t size);
+    void commit(size_t size);
+
+    // Hand every committed record to fn(const unsigned char*, size_t) and
+    // free its space. Returns the number of records consumed.
+    template<typename Fn>
+    size_t drain(Fn&& fn);
+
+    std::atomic<uint64_t> dropped{0};
+    std::atomic<bool> retired{false};  // Owning thread has exited
+
+private:
+    static constexpr uint32_t kPadding = 0;  // Record size meaning "skip to the start"
+
+    std::vector<unsigned char> buffer_;
+    size_t mask_;
+    alignas(64) std::atomic<size_t> head_{0};  // Consumer position
+    alignas(64) std::atomic<size_t> tail_{0};  // Producer position
+    size_t pending_ = 0;                       // Producer's reserved-but-uncommitted offset
+    size_t cached_head_ = 0;                   // Producer's last view of head_, refreshed when full
+};
+
+// Asynchronous logger. A log call copies the format string's address and its
+// arguments in a compact binary form into the calling thread's LogRing and
+// returns; a background thread formats the records and writes them out. The
+// hot path takes no lock and never blocks: when a ring is full the record is
+// dropped and counted.
+//
+// Formats use "{}" placeholders and must be string literals, since only their
+// address is recorded. Integers, floating point, bools, C strings and
+// std::string / string_view are supported; strings are copied (truncated to
+// kMaxStringArg bytes).
+class Logger {
+public:
+    static constexpr size_t kRingBytes = size_t(1) << 20;  // Per logging thread
+    static constexpr size_t kMaxStringArg = 512;
+
+    static Logger& instance();
+
+    // Logging stays off (every call is a single relaxed load) until start()
+    void start(FILE* out, LogLevel level = LogLevel::INFO);
+    void stop();  // Drain everything still queued and join the writer
+
+    static void set_level(LogLevel level) {
+        level_.store(static_cast<uint8_t>(level), std::memory_order_relaxed);
+    }
+
+    static LogLevel level() {
+        return static_cast<LogLevel>(level_.load(std::memory_order_relaxed));
+    }
+
+    static bool enabled(LogLevel level) {
+#if ENGINE_LOG_COMPILE_LEVEL > 0
+        if (static_cast<int>(level) < ENGINE_LOG_COMPILE_LEVEL) return false;
+#endif
+        return static_cast<uint8_t>(level) >= level_.load(std::memory_order_relaxed);
+    }
+
+    template<size_t N, typename... Args>
+    void write(LogLevel level, const char (&format)[N], const Args&... args);
+
+    // Rings registered by logging threads; a thread's ring is dropped at the
+    // first drain after the thread exits
+    size_t ring_count();
+
+private:
+    struct RecordHeader {
+        uint32_t size;        // Whole record, header included, 8-byte aligned
+        LogLevel level;
+        const char* format;
+        int64_t timestamp_ns; // Since the Unix epoch
+    };
+
+    enum ArgTag : unsigned char { kInt = 'i', kUint = 'u', kDouble = 'd', kBool = 'b', kString = 's' };
+
+    Logger() = default;
+    ~Logger();
+
+    LogRing& thread_ring();
+    void run();
+    size_t drain_all();
+    void format_record(const unsigned char* record, size_t size);
+
+    static int64_t now_ns();
+
+    template<typename T>
+    static size_t encoded_size(const T& value);
+    static size_t encoded_size(const char* value) { return 5 + clamp(std::strlen(value)); }
+    static size_t encoded_size(std::string_view value) { return 5 + clamp(value.size()); }
+    static size_t encoded_size(const std::string& value) { return 5 + clamp(value.size()); }
+
+    template<typename T>
+    static unsigned char* encode(unsigned char* out, const T& value);
+    static unsigned char* encode(unsigned char* out, const char* value) { return encode_string(out, value); }
+    static unsigned char* encode(unsigned char* out, std::string_view value) { return encode_string(out, value); }
+    static unsigned char* encode(unsigned char* out, const std::string& value) { return encode_string(out, value); }
+    static unsigned char* encode_string(unsigned char* out, std::string_view value);
+
+    static size_t clamp(size_t length) {
+        return length < kMaxStringArg ? length : kMaxStringArg;
+    }
+
+    inline static std::atomic<uint8_t> level_{static_cast<uint8_t>(LogLevel::OFF)};
+
+    FILE* out_ = nullptr;
+    std::thread writer_;
+    std::atomic<bool> running_{false};
+    std::mutex rings_mutex_;  // Guards rings_; taken once per thread and by the writer
+    std::vector<std::shared_ptr<LogRing>> rings_;
+    std::string line_;        // Writer thread's formatting buffer
+};
+
+// Arguments are only evaluated when the level is enabled
+#define ENGINE_LOG(level, ...) \
+    do { \
+        if (::trading::Logger::enabled(level)) { \
+            ::trading::Logger::instance().write(level, __VA_ARGS__); \
+        } \
+    } while (0)
+
+#define LOG_DEBUG(...) ENGINE_LOG(::trading::LogLevel::DEBUG, __VA_ARGS__)
+#define LOG_INFO(...) ENGINE_LOG(::trading::LogLevel::INFO, __VA_ARGS__)
+#define LOG_WARN(...) ENGINE_LOG(::trading::LogLevel::WARN, __VA_ARGS__)
+#define LOG_ERROR(...) ENGINE_LOG(::trading::LogLevel::ERROR, __VA_ARGS__)
+
+// --- Template definitions ---
+
+template<typename Fn>
+size_t LogRing::drain(Fn&& fn) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    size_t tail = tail_.load(std::memory_order_acquire);
+    size_t count = 0;
+    while (head != tail) {
+        size_t offset = head & mask_;
+        uint32_t size;
+        std::memcpy(&size, &buffer_[offset], sizeof(size));
+        if (size == kPadding) {
+            head += buffer_.size() - offset;
+            continue;
+        }
+        fn(&buffer_[offset], size);
+        head += size;
+        ++count;
+    }
+    head_.store(head, std::memory_order_release);
+    return count;
+}
+
+template<typename T>
+size_t Logger::encoded_size(const T&) {
+    static_assert(std::is_arithmetic<T>::value || std::is_enum<T>::value, "Unsupported log argument type");
+    return 1 + 8;
+}
+
+template<typename T>
+unsigned char* Logger::encode(unsigned char* out, const T& value) {
+    if constexpr (std::is_same<T, bool>::value) {
+        *out++ = kBool;
+        uint64_t v = value ? 1 : 0;
+        std::memcpy(out, &v, 8);
+    } else if constexpr (std::is_floating_point<T>::value) {
+        *out++ = kDouble;
+        double v = static_cast<double>(value);
+        std::memcpy(out, &v, 8);
+    } else if constexpr (std::is_enum<T>::value) {
+        *out++ = kInt;
+        int64_t v = static_cast<int64_t>(value);
+        std::memcpy(out, &v, 8);
+    } else if constexpr (std::is_signed<T>::value) {
+        *out++ = kInt;
+        int64_t v = value;
+        std::memcpy(out, &v, 8);
+    } else {
+        *out++ = kUint;
+        uint64_t v = value;
+        std::memcpy(out, &v, 8);
+    }
+    return out + 8;
+}
+
+template<size_t N, typename... Args>
+void Logger::write(LogLevel level, const char (&format)[N], const Args&... args) {
+    size_t size = sizeof(RecordHeader);
+    ((size += encoded_size(args)), ...);
+    size = (size + 7) & ~size_t(7);
+
+    LogRing& ring = thread_ring();
+    unsigned char* out = ring.reserve(size);
+    if (out == nullptr) {
+        ring.dropped.fetch_add(1, std::memory_order_relaxed);
+        return;
+    }
+
+    RecordHeader header{static_cast<uint32_t>(size), level, format, now_ns()};
+    std::memcpy(out, &header, sizeof(header));
+    unsigned char* cursor = out + sizeof(header);
+    ((cursor = encode(cursor, args)), ...);
+    std::memset(cursor, 0, static_cast<size_t>(out + size - cursor));  // Zero tag ends the arguments
+    ring.commit(size);
+}
+
+}
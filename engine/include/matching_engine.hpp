@@ -0,0 +1,267 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+#include <type_traits>
+#include "symbol_directory.hpp"
+#include "sequence_ring.hpp"
+#include "input_journal.hpp"
+
+namespace trading {
+
+struct MatchingEngineConfig {
+    size_t shards = 1;            // Pipelines the symbols are spread over, each with its own matching thread
+    size_t ring_capacity = 4096;  // Events in flight per shard between gateways and the last stage
+    int cpu = -1;                 // Pin shard i's matching stage to cpu + i and busy-poll; -1 leaves them unpinned and napping when idle
+    std::string journal_path;     // Journal every input here before matching it (shard i to "<path>.i" when sharded); empty disables the stage
+};
+
+// One symbol's top of book and trading activity as of one event, as
+// published by the market-data stage
+struct MarketData {
+    int64_t sequence = -1;        // Last event reflected, in its shard's sequence
+    Price best_bid = 0;
+    Price best_ask = 0;
+    Price spread = 0;
+    size_t order_count = 0;
+    size_t bid_levels = 0;
+    size_t ask_levels = 0;
+    OrderPoolStats pool{};
+    Price last_trade_price = 0;
+    uint64_t traded_volume = 0;   // Shares traded since start
+};
+
+static_assert(sizeof(MarketData) % sizeof(uint64_t) == 0, "MarketData is published as whole words");
+
+// One slot of the engine's ring. The gateway that claims it fills in the
+// command; the matching stage adds what it did for the stages behind it.
+// Bulk inputs and outputs (batch requests, results, trades) stay in the
+// gateway's own buffers, which the stages reach through the gateway while
+// the event is in flight, when the gateway is waiting and does not touch
+// them.
+struct EngineEvent {
+    enum class Type : uint8_t { ADD_ORDER, ADD_ORDERS, CANCEL, AMEND, QUERY, QUERY_SHARD };
+
+    // Command, written by the gateway
+    Type type;
+    uint32_t gateway;
+    SymbolId symbol;
+    OrderRequest order;       // ADD_ORDER; AMEND uses price and quantity
+    OrderId order_id;         // CANCEL, AMEND; the book's own ID
+    void (*query)(const OrderBook&, void*);  // QUERY
+    void (*shard_query)(size_t, SymbolId, const OrderBook&, void*);  // QUERY_SHARD
+    void* context;
+
+    // Outcome, written by the matching stage
+    MarketData book;          // Book once the event was applied; trade fields cover this event only
+};
+
+struct EngineResponse {
+    OrderResult result;       // ADD_ORDER
+    size_t order_count;       // Resting orders once the command was applied
+    bool success;             // CANCEL, AMEND
+    bool failed;              // The book threw; the message is in the gateway's error buffer
+    bool halted;              // Not applied: the shard's input journal had failed
+};
+
+// Thrown by a Gateway for input to a shard whose input journal has failed.
+// Nothing was applied; the shard takes no more input, though queries and
+// market data still answer.
+class EngineHalted : public std::runtime_error {
+public:
+    EngineHalted() : std::runtime_error("Input journal failed; not accepting input") {}
+};
+
+// Runs every input for the books in a SymbolDirectory through Disruptor-style
+// pipelines over preallocated SequenceRings of EngineEvents. The symbols are
+// split across config.shards such pipelines by symbol ID modulo the shard
+// count, which spreads the directory's dense IDs evenly; each shard owns its
+// books outright, so shards match in parallel without sharing anything but
+// the gateways. Gateway threads (each listener's event loop) parse requests,
+// route them to the symbol's shard, claim a slot there and write the command
+// straight into it; three stages then consume the same slots in sequence
+// order, each on its own thread:
+//
+//   journal  -- appends each input to the InputJournal (when configured)
+//   match    -- applies it to its symbol's book and answers the gateway
+//   publish  -- folds the outcome into that symbol's MarketData (behind match)
+//
+// When journaling, match follows journal, so every input a gateway sees
+// answered was written to the journal first. Written means handed to write();
+// there is no fsync, so the journal survives the engine crashing but not the
+// machine. If a write fails, the events of that batch and every input after
+// them are not applied and fail with EngineHalted instead. Each stage
+// drains whatever is available as one batch, so a slow stage catches up
+// instead of holding the others back event by event. A book is only ever
+// touched by its shard's matching stage, so matching stays deterministic and
+// lock-free per symbol, parsing scales with the number of gateways and
+// matching with the number of shards.
+//
+// Responses are encoded by the gateway that asked, not by a stage: each
+// gateway writes straight into its own connection's buffer, so encoding
+// already runs in parallel, and a shared stage would funnel every
+// connection's output through one thread.
+//
+// Order IDs going in and out are engine-wide (see SymbolDirectory), so
+// cancels and amends route by ID alone. Add every symbol to the directory
+// before constructing the engine, and register every gateway with
+// add_gateway() before start().
+class MatchingEngine {
+    struct Shard;
+
+public:
+    // One thread's handle on the engine. Calls mirror OrderBook's, with the
+    // symbol up front, and block until the matching stage has answered;
+    // trades from the last call are in trades(). The symbol must be in the
+    // directory. A price the book refuses throws std::out_of_range in the
+    // calling thread, as OrderBook would.
+    class Gateway {
+    public:
+        OrderResult add_order(SymbolId symbol, Price price, Quantity quantity, Side side, TimeInForce tif);
+        OrderResult add_market_order(SymbolId symbol, Quantity quantity, Side side, uint32_t protection_ticks);
+        void add_orders(SymbolId symbol, const std::vector<OrderRequest>& requests, std::vector<OrderResult>& results);
+        bool cancel_order(OrderId order_id);
+        bool amend_order(OrderId order_id, Price price, Quantity quantity);
+
+        // Run fn(const OrderBook&) against one symbol's book on the matching
+        // stage, for reads that need the book itself (trade history, depth).
+        // Order IDs seen there are the book's own.
+        template<typename Fn>
+        void query(SymbolId symbol, Fn&& fn) {
+            EngineEvent& event = claim(EngineEvent::Type::QUERY, symbol);
+            event.query = [](const OrderBook& book, void* context) {
+                (*static_cast<std::remove_reference_t<Fn>*>(context))(book);
+            };
+            event.context = &fn;
+            submit();
+        }
+
+        // Run fn(shard, symbol, const OrderBook&) against every book, for
+        // engine-wide reads: each shard calls it for its own symbols on its
+        // own matching stage, all shards at once, and the call returns once
+        // every shard has. fn must not throw, and may only write state kept
+        // per shard index.
+        template<typename Fn>
+        void query_all(Fn&& fn) {
+            fan_out([](size_t shard, SymbolId symbol, const OrderBook& book, void* context) {
+                (*static_cast<std::remove_reference_t<Fn>*>(context))(shard, symbol, book);
+            }, &fn);
+        }
+
+        // Latest published MarketData for a symbol, at least as recent as
+        // every event any gateway had answered before the call
+        MarketData market_data(SymbolId symbol) const;
+
+        const SymbolDirectory& symbols() const { return engine_.symbols_; }
+        size_t shard_count() const { return engine_.shards_.size(); }
+        size_t shard_of(SymbolId symbol) const { return engine_.shard_of(symbol); }
+        const std::vector<Trade>& trades() const { return trades_; }
+        // Resting orders in the last call's book
+        size_t order_count() const { return response_.order_count; }
+
+    private:
+        friend class MatchingEngine;
+
+        Gateway(MatchingEngine& engine, uint32_t id) : engine_(engine), id_(id) {}
+
+        EngineEvent& claim(EngineEvent::Type type, SymbolId symbol);
+        const EngineResponse& submit();
+        void fan_out(void (*shard_query)(size_t, SymbolId, const OrderBook&, void*), void* context);
+
+        MatchingEngine& engine_;
+        uint32_t id_;
+        Shard* shard_ = nullptr;  // Where the event in flight went
+        int64_t sequence_ = -1;   // Event in flight
+        std::vector<int64_t> fan_out_sequences_;  // query_all's event on each shard
+
+        // Written by the matching stage while an event is in flight
+        EngineResponse response_{};
+        std::vector<Trade> trades_;
+        const std::vector<OrderRequest>* batch_requests_ = nullptr;
+        std::vector<OrderResult>* batch_results_ = nullptr;
+        std::string error_;
+    };
+
+    explicit MatchingEngine(SymbolDirectory& symbols, const MatchingEngineConfig& config = MatchingEngineConfig());
+    ~MatchingEngine();
+
+    MatchingEngine(const MatchingEngine&) = delete;
+    MatchingEngine& operator=(const MatchingEngine&) = delete;
+
+    Gateway& add_gateway();
+
+    void start();
+    // Stop once every stage has drained the ring; gateways must be idle
+    void stop();
+
+    // False if config.journal_path was set but could not be opened; the
+    // engine then runs without journal stages
+    bool journaling() const { return journaling_; }
+
+    size_t shard_count() const { return shards_.size(); }
+    size_t shard_of(SymbolId symbol) const { return symbol % shards_.size(); }
+
+private:
+    // One pipeline and the books it owns: the symbols whose ID modulo the
+    // shard count is its index
+    struct Shard {
+        Shard(size_t index, size_t ring_capacity, std::unique_ptr<InputJournal> journal);
+
+        bool halted() const { return journal_failed_at.load(std::memory_order_acquire) != kNotFailed; }
+
+        static constexpr int64_t kNotFailed = INT64_MAX;
+
+        size_t index;
+        SequenceRing<EngineEvent> ring;
+        std::unique_ptr<InputJournal> journal;  // Null when not journaling
+        std::atomic<int64_t> journal_failed_at{kNotFailed};  // First sequence the journal lost
+
+        Sequence journaled;
+        Sequence matched;
+        Sequence published;
+        SequenceBarrier<EngineEvent> journal_barrier;
+        SequenceBarrier<EngineEvent> match_barrier;
+        SequenceBarrier<EngineEvent> publish_barrier;
+
+        std::vector<SymbolId> symbols;
+
+        // Publisher only: working copies by symbol / shard count, and the
+        // symbols the current batch touched
+        std::vector<MarketData> market_data;
+        std::vector<SymbolId> touched;
+        std::vector<bool> is_touched;
+    };
+
+    template<typename Handler>
+    void run_stage(Shard& shard, Sequence& progress, const SequenceBarrier<EngineEvent>& barrier, bool never_sleep, Handler&& handler);
+
+    void run_shard(Shard& shard);
+    void journal(Shard& shard, int64_t sequence, const EngineEvent& event);
+    void execute(Shard& shard, int64_t sequence, EngineEvent& event);
+    void publish(Shard& shard, int64_t first, int64_t last);
+    void store_market_data(Shard& shard, SymbolId symbol);
+
+    SymbolDirectory& symbols_;
+    MatchingEngineConfig config_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<std::unique_ptr<Gateway>> gateways_;
+    bool journaling_ = false;  // Journal stages run; fixed at construction
+
+    // A symbol's published snapshot behind a seqlock: the version is odd
+    // while the publisher writes, and readers retry until they copy a
+    // stable one
+    static constexpr size_t kMarketDataWords = sizeof(MarketData) / sizeof(uint64_t);
+    struct alignas(64) PublishedMarketData {
+        std::atomic<uint64_t> version{0};
+        std::atomic<uint64_t> words[kMarketDataWords] = {};
+    };
+    std::unique_ptr<PublishedMarketData[]> published_market_data_;
+
+    std::vector<std::thread> threads_;
+    std::atomic<bool> running_{false};
+};
+
+}
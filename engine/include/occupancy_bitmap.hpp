@@ -0,0 +1,131 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+
+namespace trading {
+
+// Multi-level bitset marking which price levels are populated. Level 0 holds
+// one bit per slot; each bit of level k+1 says whether the matching 64-bit
+// word of level k is non-zero, up to a single summary word. Finding the next
+// set bit in either direction costs one ctz/clz per level, independent of how
+// many empty slots lie in between.
+class OccupancyBitmap {
+public:
+    static constexpr size_t npos = static_cast<size_t>(-1);
+
+private:
+    std::vector<std::vector<uint64_t>> levels_;  // levels_[0] is the leaf level
+    size_t size_;
+
+    static constexpr uint64_t kOne = 1;
+
+public:
+    explicit OccupancyBitmap(size_t size = 0) : size_(0) {
+        reset(size);
+    }
+
+    // Resize to `size` bits, all clear
+    void reset(size_t size) {
+        size_ = size;
+        levels_.clear();
+        size_t bits = size > 0 ? size : 1;
+        do {
+            size_t words = (bits + 63) / 64;
+            levels_.emplace_back(words, 0);
+            bits = words;
+        } while (bits > 1);
+    }
+
+    size_t size() const {
+        return size_;
+    }
+
+    bool test(size_t i) const {
+        return (levels_[0][i >> 6] >> (i & 63)) & kOne;
+    }
+
+    void set(size_t i) {
+        for (auto& level : levels_) {
+            uint64_t& word = level[i >> 6];
+            bool was_empty = word == 0;
+            word |= kOne << (i & 63);
+            if (!was_empty) return;
+            i >>= 6;
+        }
+    }
+
+    void clear(size_t i) {
+        for (auto& level : levels_) {
+            uint64_t& word = level[i >> 6];
+            word &= ~(kOne << (i & 63));
+            if (word != 0) return;
+            i >>= 6;
+        }
+    }
+
+    bool none() const {
+        return levels_.back()[0] == 0;
+    }
+
+    // Smallest set index >= i, or npos
+    size_t find_next(size_t i) const {
+        size_t lvl = 0;
+        for (;;) {
+            size_t w = i >> 6;
+            if (w >= levels_[lvl].size()) return npos;
+
+            uint64_t word = levels_[lvl][w] & (~uint64_t(0) << (i & 63));
+            if (word != 0) {
+                i = (w << 6) + static_cast<size_t>(__builtin_ctzll(word));
+                break;
+            }
+            if (lvl + 1 == levels_.size()) return npos;
+            i = w + 1;
+            ++lvl;
+        }
+
+        while (lvl > 0) {
+            --lvl;
+            i = (i << 6) + static_cast<size_t>(__builtin_ctzll(levels_[lvl][i]));
+        }
+        return i;
+    }
+
+    // Largest set index <= i, or npos
+    size_t find_prev(size_t i) const {
+        if (i >= size_) {
+            if (size_ == 0) return npos;
+            i = size_ - 1;
+        }
+
+        size_t lvl = 0;
+        for (;;) {
+            size_t w = i >> 6;
+            uint64_t word = levels_[lvl][w] & (~uint64_t(0) >> (63 - (i & 63)));
+            if (word != 0) {
+                i = (w << 6) + 63 - static_cast<size_t>(__builtin_clzll(word));
+                break;
+            }
+            if (w == 0 || lvl + 1 == levels_.size()) return npos;
+            i = w - 1;
+            ++lvl;
+        }
+
+        while (lvl > 0) {
+            --lvl;
+            i = (i << 6) + 63 - static_cast<size_t>(__builtin_clzll(levels_[lvl][i]));
+        }
+        return i;
+    }
+
+    size_t first() const {
+        return find_next(0);
+    }
+
+    size_t last() const {
+        return find_prev(size_);
+    }
+};
+
+}
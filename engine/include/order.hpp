@@ -8,8 +8,11 @@ namespace trading {
 using OrderId = uint64_t;
 using Price = uint64_t;      
 using Quantity = uint32_t;
+using OrderHandle = uint32_t;  // Dense index of an order slot in its OrderPool
 using Timestamp = std::chrono::time_point<std::chrono::high_resolution_clock>;
 
+class PriceLevel;
+
 enum class Side : uint8_t {
     BUY = 0,
     SELL = 1
@@ -23,48 +26,70 @@ enum class OrderStatus : uint8_t {
     REJECTED = 4
 };
 
-struct Order {
-    OrderId id;
-    Price price;
-    Quantity quantity;
-    Quantity filled_quantity;
-    Side side;
-    OrderStatus status;
-    Timestamp timestamp;
-    
+enum class TimeInForce : uint8_t {
+    GTC = 0,  // Good till cancel: remainder rests on the book
+    IOC = 1,  // Immediate or cancel: remainder is cancelled
+    FOK = 2   // Fill or kill: fill completely or do nothing
+};
+
+enum class OrderType : uint8_t {
+    LIMIT = 0,
+    MARKET = 1  // Takes whatever liquidity is there; never rests
+};
+
+// Hot record: everything the matching loop reads or writes, packed so two
+// orders share a cache line and a record never straddles one
+struct alignas(32) Order {
     Order* next;
     Order* prev;
+    OrderId id;
+    Quantity remaining;
+    Side side;
     
-    Order(OrderId id_, Price price_, Quantity quantity_, Side side_)
-        : id(id_)
-        , price(price_)
-        , quantity(quantity_)
-        , filled_quantity(0)
-        , side(side_)
-        , status(OrderStatus::NEW)
-        , timestamp(std::chrono::high_resolution_clock::now())
-        , next(nullptr)
+    Order(OrderId id_, Quantity quantity_, Side side_)
+        : next(nullptr)
         , prev(nullptr)
+        , id(id_)
+        , remaining(quantity_)
+        , side(side_)
     {}
     
     bool is_fully_filled() const {
-        return filled_quantity >= quantity;
+        return remaining == 0;
     }
     
     Quantity remaining_quantity() const {
-        return quantity - filled_quantity;
+        return remaining;
     }
     
     void fill(Quantity qty) {
-        filled_quantity += qty;
-        if (is_fully_filled()) {
-            status = OrderStatus::FILLED;
-        } else {
-            status = OrderStatus::PARTIALLY_FILLED;
-        }
+        remaining -= qty;
     }
 };
 
+static_assert(sizeof(Order) == 32, "Order hot record must stay at 32 bytes");
+static_assert(alignof(Order) == 32, "Order hot record must be 32-byte aligned");
+
+// Cold record: order metadata kept in a parallel array by OrderPool and only
+// touched on entry, cancel and reporting
+struct OrderInfo {
+    Price price;
+    Timestamp timestamp;
+    PriceLevel* level;     // Level the order rests on, nullptr until it is booked
+    Quantity quantity;     // Original size
+    OrderStatus status;
+    
+    OrderInfo(Price price_, Quantity quantity_)
+        : price(price_)
+        , timestamp(std::chrono::high_resolution_clock::now())
+        , level(nullptr)
+        , quantity(quantity_)
+        , status(OrderStatus::NEW)
+    {}
+};
+
+static_assert(sizeof(OrderInfo) <= 32, "OrderInfo should stay within 32 bytes");
+
 struct Trade {
     OrderId buyer_id;
     OrderId seller_id;
@@ -72,6 +97,14 @@ struct Trade {
     Quantity quantity;
     Timestamp timestamp;
     
+    Trade()
+        : buyer_id(0)
+        , seller_id(0)
+        , price(0)
+        , quantity(0)
+        , timestamp()
+    {}
+    
     Trade(OrderId buyer, OrderId seller, Price p, Quantity qty)
         : buyer_id(buyer)
         , seller_id(seller)
@@ -81,6 +114,24 @@ struct Trade {
     {}
 };
 
+// One entry of a batch submitted through OrderBook::add_orders
+struct OrderRequest {
+    Price price;                // Ignored for market orders
+    Quantity quantity;
+    Side side;
+    OrderType type;
+    TimeInForce tif;            // Market orders always behave as IOC
+    uint32_t protection_ticks;  // Market orders only; OrderBook::kUnprotected for no band
+};
+
+// Outcome of an add_order call
+struct OrderResult {
+    OrderId order_id;          // 0 if the order was rejected before entering the book
+    OrderStatus status;
+    Quantity filled_quantity;
+    Quantity resting_quantity; // Left on the book, only non-zero for GTC
+};
+
 inline std::string side_to_string(Side side) {
     return side == Side::BUY ? "BUY" : "SELL";
 }
@@ -96,6 +147,23 @@ inline std::string status_to_string(OrderStatus status) {
     }
 }
 
+inline std::string tif_to_string(TimeInForce tif) {
+    switch (tif) {
+        case TimeInForce::GTC: return "GTC";
+        case TimeInForce::IOC: return "IOC";
+        case TimeInForce::FOK: return "FOK";
+        default: return "UNKNOWN";
+    }
+}
+
+inline std::string order_type_to_string(OrderType type) {
+    switch (type) {
+        case OrderType::LIMIT: return "LIMIT";
+        case OrderType::MARKET: return "MARKET";
+        default: return "UNKNOWN";
+    }
+}
+
 inline double price_to_double(Price price) {
     return static_cast<double>(price) / 100.0;
 }
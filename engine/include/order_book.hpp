@@ -1,46 +1,323 @@
 #pragma once
-#include <map>
 #include <vector>
 #include <memory>
+#include <algorithm>
+#include <stdexcept>
+#include <utility>
+#include <limits>
 #include "order.hpp"
 #include "price_level.hpp"
+#include "price_ladder.hpp"
+#include "order_pool.hpp"
+#include "order_index.hpp"
+#include "trade_sink.hpp"
+#include "trade_journal.hpp"
 
 namespace trading {
 
 class OrderBook {
+public:
+    // Protection band meaning "sweep as far as the book goes"
+    static constexpr uint32_t kUnprotected = std::numeric_limits<uint32_t>::max();
+
 private:
-    std::map<Price, PriceLevel, std::greater<Price>> bids_; // Highest price first
-    std::map<Price, PriceLevel, std::less<Price>> asks_;    // Lowest price first
-    std::map<OrderId, Order*> orders_;
-    std::vector<Trade> trades_;
+    PriceLadder<Side::BUY> bids_;  // Highest price is best
+    PriceLadder<Side::SELL> asks_; // Lowest price is best
+    OrderPool order_pool_;
+    OrderIndex orders_;
+    TradeJournal trades_;
     OrderId next_order_id_;
     
 public:
-    OrderBook() : next_order_id_(1) {}
-    // Clean up raw pointers in destructor
-    ~OrderBook() { for (auto& [id, order] : orders_) delete order; }
+    explicit OrderBook(Price tick_size = 1,
+                       size_t max_levels = PriceLadder<Side::BUY>::kDefaultMaxLevels,
+                       size_t order_capacity = OrderPool::kOrdersPerSlab)
+        : bids_(tick_size, max_levels), asks_(tick_size, max_levels)
+        , order_pool_(order_capacity), next_order_id_(1) {}
+
+    std::vector<Trade> add_order(Price price, Quantity quantity, Side side,
+                                 TimeInForce tif = TimeInForce::GTC);
+
+    // Same as above, but each trade is handed to `sink` (any callable taking
+    // const Trade&, e.g. a lambda or TradeSpanSink) as it happens, with no
+    // heap allocation on the way. FOK orders are checked against the opposite
+    // side's level totals first and rejected without side effects if they
+    // cannot fill completely. A GTC price the ladder cannot hold throws
+    // std::out_of_range; IOC and FOK prices need only be on the tick grid.
+    template<typename Sink>
+    OrderResult add_order(Price price, Quantity quantity, Side side, TimeInForce tif, Sink&& sink);
+
+    template<typename Sink>
+    OrderResult add_order(Price price, Quantity quantity, Side side, Sink&& sink) {
+        return add_order(price, quantity, side, TimeInForce::GTC, std::forward<Sink>(sink));
+    }
+
+    // Market order: sweeps the opposite side at any price and discards
+    // whatever cannot fill, so it never rests or creates a level. With a
+    // protection band it stops at protection_ticks ticks through the
+    // opposite best price seen on arrival.
+    std::vector<Trade> add_market_order(Quantity quantity, Side side, uint32_t protection_ticks = kUnprotected);
+
+    template<typename Sink>
+    OrderResult add_market_order(Quantity quantity, Side side, uint32_t protection_ticks, Sink&& sink);
+
+    // Enter a batch in order, writing one result per request; trades from
+    // the whole batch go to the sink in execution order. Unlike add_order, a
+    // price the ladder cannot hold rejects just that entry (order_id 0,
+    // REJECTED) rather than throwing, so it cannot abort the rest of the batch.
+    std::vector<OrderResult> add_orders(const std::vector<OrderRequest>& requests, std::vector<Trade>& trades);
+
+    template<typename Sink>
+    void add_orders(const OrderRequest* requests, size_t count, OrderResult* results, Sink&& sink);
 
-    std::vector<Trade> add_order(Price price, Quantity quantity, Side side);
     bool cancel_order(OrderId order_id);
+
+    // Change a resting order's price and total quantity, keeping its ID.
+    // Reducing quantity at the same price is done in place and keeps time
+    // priority; a larger quantity or a new price moves the order to the back
+    // of its new level, matching first if the new price crosses. A quantity
+    // at or below what has already filled cancels the order. Returns false if
+    // the order is not resting; a new price the ladder cannot hold, once the
+    // order has left its old one, throws std::out_of_range and changes nothing.
+    bool amend_order(OrderId order_id, Price new_price, Quantity new_quantity);
+
+    template<typename Sink>
+    bool amend_order(OrderId order_id, Price new_price, Quantity new_quantity, Sink&& sink);
     
-    Price get_best_bid() const { return bids_.empty() ? 0 : bids_.begin()->first; }
-    Price get_best_ask() const { return asks_.empty() ? 0 : asks_.begin()->first; }
+    Price get_best_bid() const { return bids_.best_price(); }
+    Price get_best_ask() const { return asks_.best_price(); }
     Price get_spread() const { return (bids_.empty() || asks_.empty()) ? 0 : get_best_ask() - get_best_bid(); }
     size_t get_order_count() const { return orders_.size(); }
-    size_t get_bid_level_count() const { return bids_.size(); }
-    size_t get_ask_level_count() const { return asks_.size(); }
+    size_t get_bid_level_count() const { return bids_.level_count(); }
+    size_t get_ask_level_count() const { return asks_.level_count(); }
+    Price get_tick_size() const { return bids_.tick_size(); }
+    OrderPoolStats get_pool_stats() const { return order_pool_.stats(); }
+    
+    TradeJournal& get_trade_journal() { return trades_; }
+    const TradeJournal& get_trade_journal() const { return trades_; }
     
     void print() const;
     
 private:
-    std::vector<Trade> match_order(Order* order);
+    // Allocate, index and match an order that passed validation; rest the
+    // remainder only for GTC
+    template<typename Sink>
+    OrderResult enter_order(Price price, Quantity quantity, Side side, TimeInForce tif, Sink& sink);
+
+    template<typename Sink>
+    void match_order(Order* order, Sink& sink);
     
-    // The Template Helper that fixes the ternary error
-    template<typename T>
-    void match_against(Order* taker_order, T& opposite_side, std::vector<Trade>& trades);
+    // Matching kernel specialized on the taker side, so the cross check and
+    // buyer/seller assignment are resolved at compile time
+    template<Side TakerSide, typename Sink>
+    void match_against(Order* taker_order, Sink& sink);
+
+    template<Side TakerSide>
+    auto& opposite_side() {
+        if constexpr (TakerSide == Side::BUY) {
+            return asks_;
+        } else {
+            return bids_;
+        }
+    }
+
+    // Whether the opposite side holds enough marketable quantity, from
+    // level aggregates only
+    bool can_fill(Price price, Quantity quantity, Side side) const;
 
     void add_to_book(Order* order);
     void remove_from_book(Order* order);
+
+    // An IOC or FOK order never rests, and matching only compares prices, so
+    // it needs no ladder slot: any price on the tick grid will do. A GTC
+    // order must fit its side's window.
+    bool accepts(Price price, Side side, TimeInForce tif) const {
+        if (tif != TimeInForce::GTC) return bids_.on_grid(price);
+        return (side == Side::BUY) ? bids_.can_hold(price) : asks_.can_hold(price);
+    }
 };
 
-}
\ No newline at end of file
+// --- Matching (templated so the trade sink inlines into the fill loop) ---
+
+template<typename Sink>
+OrderResult OrderBook::add_order(Price price, Quantity quantity, Side side, TimeInForce tif, Sink&& sink) {
+    // Reject up front so a refused order never leaves partial fills behind
+    if (!accepts(price, side, tif)) {
+        throw std::out_of_range("Price is off the tick grid or outside the book's price ladder");
+    }
+    if (tif == TimeInForce::FOK && !can_fill(price, quantity, side)) {
+        return OrderResult{0, OrderStatus::REJECTED, 0, 0};
+    }
+    return enter_order(price, quantity, side, tif, sink);
+}
+
+template<typename Sink>
+OrderResult OrderBook::add_market_order(Quantity quantity, Side side, uint32_t protection_ticks, Sink&& sink) {
+    // An unprotected market order gets a limit every resting price crosses
+    Price limit = (side == Side::BUY) ? std::numeric_limits<Price>::max() : 0;
+
+    if (protection_ticks != kUnprotected) {
+        Price band = static_cast<Price>(protection_ticks) * get_tick_size();
+        if (side == Side::BUY && !asks_.empty()) {
+            Price best = asks_.best_price();
+            limit = band <= limit - best ? best + band : limit;
+        } else if (side == Side::SELL && !bids_.empty()) {
+            Price best = bids_.best_price();
+            limit = best > band ? best - band : 0;
+        }
+    }
+    return enter_order(limit, quantity, side, TimeInForce::IOC, sink);
+}
+
+template<typename Sink>
+void OrderBook::add_orders(const OrderRequest* requests, size_t count, OrderResult* results, Sink&& sink) {
+    for (size_t i = 0; i < count; ++i) {
+        const OrderRequest& req = requests[i];
+        if (req.type == OrderType::MARKET) {
+            results[i] = add_market_order(req.quantity, req.side, req.protection_ticks, sink);
+            continue;
+        }
+
+        if (!accepts(req.price, req.side, req.tif) || (req.tif == TimeInForce::FOK && !can_fill(req.price, req.quantity, req.side))) {
+            results[i] = OrderResult{0, OrderStatus::REJECTED, 0, 0};
+        } else {
+            results[i] = enter_order(req.price, req.quantity, req.side, req.tif, sink);
+        }
+    }
+}
+
+template<typename Sink>
+OrderResult OrderBook::enter_order(Price price, Quantity quantity, Side side, TimeInForce tif, Sink& sink) {
+    Order* order = order_pool_.acquire(next_order_id_++, price, quantity, side);
+    orders_.insert(order->id, order);
+    match_order(order, sink);
+
+    OrderResult result{order->id, OrderStatus::FILLED, quantity - order->remaining_quantity(), 0};
+    if (!order->is_fully_filled() && tif == TimeInForce::GTC) {
+        result.status = result.filled_quantity > 0 ? OrderStatus::PARTIALLY_FILLED : OrderStatus::NEW;
+        result.resting_quantity = order->remaining_quantity();
+        OrderPool::info(order).status = result.status;
+        add_to_book(order);
+    } else {
+        // Filled, or the unfilled remainder of an IOC is cancelled
+        if (!order->is_fully_filled()) result.status = OrderStatus::CANCELLED;
+        orders_.erase(order->id);
+        order_pool_.release(order);
+    }
+    return result;
+}
+
+template<typename Sink>
+bool OrderBook::amend_order(OrderId order_id, Price new_price, Quantity new_quantity, Sink&& sink) {
+    Order* order = orders_.find(order_id);
+    if (order == nullptr) {
+        return false;
+    }
+
+    OrderInfo& info = OrderPool::info(order);
+    bool removed = false;
+    if (new_price != info.price) {
+        bool fits = (order->side == Side::BUY) ? bids_.can_hold(new_price) : asks_.can_hold(new_price);
+        if (!fits && order->prev == nullptr && order->next == nullptr) {
+            // Alone at its level, the order may be what pins the window's far
+            // end; check again without it. Putting it back leaves it alone at
+            // the same level, so a refusal still changes nothing.
+            remove_from_book(order);
+            fits = (order->side == Side::BUY) ? bids_.can_hold(new_price) : asks_.can_hold(new_price);
+            if (!fits) add_to_book(order);
+            removed = fits;
+        }
+        if (!fits) {
+            throw std::out_of_range("Price is off the tick grid or outside the book's price ladder");
+        }
+    }
+
+    Quantity filled = info.quantity - order->remaining_quantity();
+    if (new_quantity <= filled) {
+        if (!removed) remove_from_book(order);
+        orders_.erase(order_id);
+        order_pool_.release(order);
+        return true;
+    }
+    Quantity new_remaining = new_quantity - filled;
+
+    // Same price, smaller size: shrink in place and keep queue position
+    if (new_price == info.price && new_remaining <= order->remaining_quantity()) {
+        info.level->reduce_order(order, new_remaining);
+        info.quantity = new_quantity;
+        return true;
+    }
+
+    // Anything else loses priority: unlink, re-price, and re-enter as if new
+    if (!removed) remove_from_book(order);
+    order->remaining = new_remaining;
+    info.price = new_price;
+    info.quantity = new_quantity;
+    info.timestamp = std::chrono::high_resolution_clock::now();
+
+    match_order(order, sink);
+    if (!order->is_fully_filled()) {
+        info.status = order->remaining_quantity() < new_quantity ? OrderStatus::PARTIALLY_FILLED : OrderStatus::NEW;
+        add_to_book(order);
+    } else {
+        orders_.erase(order->id);
+        order_pool_.release(order);
+    }
+    return true;
+}
+
+template<typename Sink>
+void OrderBook::match_order(Order* order, Sink& sink) {
+    if (order->side == Side::BUY) {
+        match_against<Side::BUY>(order, sink);
+    } else {
+        match_against<Side::SELL>(order, sink);
+    }
+}
+
+template<Side TakerSide, typename Sink>
+void OrderBook::match_against(Order* taker_order, Sink& sink) {
+    auto& book_side = opposite_side<TakerSide>();
+    const Price limit_price = OrderPool::info(taker_order).price;
+    const OrderId taker_id = taker_order->id;
+
+    while (!taker_order->is_fully_filled() && book_side.crosses(limit_price)) {
+        PriceLevel& price_level = book_side.best_level();
+        Price best_resting_price = price_level.get_price();
+
+        while (!taker_order->is_fully_filled() && !price_level.is_empty()) {
+            Order* maker_order = price_level.get_head();
+            Quantity fill_qty = std::min(taker_order->remaining_quantity(), maker_order->remaining_quantity());
+
+            // Generate Trade record
+            Trade trade(
+                TakerSide == Side::BUY ? taker_id : maker_order->id,
+                TakerSide == Side::SELL ? taker_id : maker_order->id,
+                best_resting_price,
+                fill_qty
+            );
+            
+            sink(trade);
+            trades_.append(trade);
+
+            // Update quantities
+            taker_order->fill(fill_qty);
+            maker_order->fill(fill_qty);
+            price_level.update_quantity(fill_qty);
+
+            if (maker_order->is_fully_filled()) {
+                price_level.remove_order(maker_order);
+                orders_.erase(maker_order->id);
+                order_pool_.release(maker_order);
+            } else {
+                OrderPool::info(maker_order).status = OrderStatus::PARTIALLY_FILLED;
+            }
+        }
+
+        if (price_level.is_empty()) {
+            book_side.pop_best();
+        }
+    }
+}
+
+}
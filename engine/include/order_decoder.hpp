@@ -0,0 +1,38 @@
+#pragma once
+#include <string_view>
+#include "order.hpp"
+
+namespace trading {
+
+// Single-pass decoders for the hot request bodies (POST /order and
+// DELETE /order). They scan the bytes once, allocate nothing and parse prices
+// as exact decimals straight into cents, rounding half up.
+//
+// A decoder returns true only for a request that passes every check the
+// nlohmann-based handlers apply. It returns false for everything else, invalid
+// or merely unusual (escaped strings, exponents, duplicate keys), and the
+// caller falls back to the DOM path, which then reports the same error as
+// before.
+
+// The instrument an order names: a symbol name, a numeric SymbolId, or
+// nothing for the default symbol. A name views the request body.
+struct SymbolField {
+    enum Kind : uint8_t { NONE, NAME, ID };
+    Kind kind = NONE;
+    std::string_view name;
+    uint64_t id = 0;
+};
+
+// Fills req, the symbol it names and, for limit orders, the submitted price
+// in dollars for echoing
+bool decode_order_request(std::string_view body, OrderRequest& req, double& price_received, SymbolField& symbol);
+
+bool decode_cancel_request(std::string_view body, OrderId& order_id);
+
+// Dollars written as a non-negative JSON number into cents, exactly, rounding
+// half up on the third decimal. The decoder and the DOM path both price
+// through this, the latter on the shortest text of the parsed double, so a
+// number gives the same cents whichever path reads it.
+bool decimal_to_cents(std::string_view text, Price& cents);
+
+}
@@ -0,0 +1,97 @@
+#pragma once
+#include <vector>
+#include <memory>
+#include <cstddef>
+#include <cstdint>
+#include "order.hpp"
+
+namespace trading {
+
+// Paged direct-mapped table from OrderId to Order*. IDs are handed out densely
+// by OrderBook, so id >> kPageBits selects a page and the low bits select the
+// slot: lookup, insert and erase are a couple of array accesses. A page whose
+// IDs have all been issued and then removed is recycled for later IDs.
+class OrderIndex {
+public:
+    static constexpr size_t kPageBits = 12;
+    static constexpr size_t kPageSize = size_t(1) << kPageBits;
+
+private:
+    struct Page {
+        Order* slots[kPageSize];
+        size_t live;  // Non-null slots
+    };
+
+    std::vector<Page*> directory_;              // Page number -> page, nullptr if not mapped
+    std::vector<std::unique_ptr<Page>> pages_;  // Owns every page ever allocated
+    std::vector<Page*> spare_pages_;            // Retired pages ready for reuse
+    OrderId max_id_;                            // Highest ID inserted so far
+    size_t size_;
+
+public:
+    OrderIndex() : max_id_(0), size_(0) {}
+
+    OrderIndex(const OrderIndex&) = delete;
+    OrderIndex& operator=(const OrderIndex&) = delete;
+
+    size_t size() const {
+        return size_;
+    }
+
+    Order* find(OrderId id) const {
+        size_t page_no = static_cast<size_t>(id >> kPageBits);
+        if (page_no >= directory_.size() || directory_[page_no] == nullptr) return nullptr;
+        return directory_[page_no]->slots[id & (kPageSize - 1)];
+    }
+
+    void insert(OrderId id, Order* order) {
+        size_t page_no = static_cast<size_t>(id >> kPageBits);
+        if (page_no >= directory_.size()) directory_.resize(page_no + 1, nullptr);
+
+        Page*& page = directory_[page_no];
+        if (page == nullptr) page = take_page();
+
+        Order*& slot = page->slots[id & (kPageSize - 1)];
+        if (slot == nullptr) {
+            ++page->live;
+            ++size_;
+        }
+        slot = order;
+        if (id > max_id_) max_id_ = id;
+    }
+
+    bool erase(OrderId id) {
+        size_t page_no = static_cast<size_t>(id >> kPageBits);
+        if (page_no >= directory_.size() || directory_[page_no] == nullptr) return false;
+
+        Page* page = directory_[page_no];
+        Order*& slot = page->slots[id & (kPageSize - 1)];
+        if (slot == nullptr) return false;
+
+        slot = nullptr;
+        --page->live;
+        --size_;
+
+        // Once every ID in the page has been issued no new entry can land
+        // here, so an empty page goes back on the spare list
+        OrderId last_id_in_page = (static_cast<OrderId>(page_no) << kPageBits) | (kPageSize - 1);
+        if (page->live == 0 && max_id_ >= last_id_in_page) {
+            directory_[page_no] = nullptr;
+            spare_pages_.push_back(page);
+        }
+        return true;
+    }
+
+private:
+    Page* take_page() {
+        if (!spare_pages_.empty()) {
+            Page* page = spare_pages_.back();
+            spare_pages_.pop_back();
+            return page;
+        }
+        pages_.emplace_back(new Page());
+        return pages_.back().get();
+    }
+};
+
+}
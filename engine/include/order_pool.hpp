@@ -0,0 +1,128 @@
+#pragma once
+#include <vector>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include "order.hpp"
+
+namespace trading {
+
+struct OrderPoolStats {
+    size_t capacity;         // Order slots allocated across all slabs
+    size_t in_use;           // Slots currently handed out
+    size_t high_water_mark;  // Largest in_use seen since construction
+    size_t slab_count;
+};
+
+// Growable slab allocator for orders. Each slab is aligned to its own size and
+// holds a dense array of hot Order records followed by a parallel array of
+// cold OrderInfo records, so the info for an Order* is found with a mask and
+// a shift. Every slot also has a 32-bit OrderHandle for containers that want
+// compact references instead of pointers. Slabs are never moved or freed
+// before the pool dies, so Order pointers stay valid while the order lives.
+// Released slots are threaded onto an intrusive free list, which keeps the
+// add/cancel/match paths away from the general-purpose allocator.
+class OrderPool {
+public:
+    static constexpr size_t kSlabBytes = size_t(1) << 18;  // Also the slab alignment
+    static constexpr size_t kHotOffset = 64;  // Slab header: the slab's index in slabs_
+    static constexpr size_t kOrdersPerSlab = (kSlabBytes - kHotOffset) / (sizeof(Order) + sizeof(OrderInfo));
+    static constexpr size_t kColdOffset = kHotOffset + kOrdersPerSlab * sizeof(Order);
+
+private:
+    union Slot {
+        Slot* next_free;
+        alignas(Order) unsigned char storage[sizeof(Order)];
+    };
+
+    static_assert(sizeof(Slot) == sizeof(Order), "Slot must overlay an Order exactly");
+    static_assert(kColdOffset % alignof(OrderInfo) == 0, "OrderInfo array misaligned");
+    static_assert(kColdOffset + kOrdersPerSlab * sizeof(OrderInfo) <= kSlabBytes, "Slab overflow");
+
+    std::vector<unsigned char*> slabs_;
+    Slot* free_list_;
+    size_t in_use_;
+    size_t high_water_mark_;
+
+public:
+    explicit OrderPool(size_t initial_capacity = kOrdersPerSlab)
+        : free_list_(nullptr)
+        , in_use_(0)
+        , high_water_mark_(0)
+    {
+        while (capacity() < initial_capacity) add_slab();
+    }
+
+    ~OrderPool() {
+        for (unsigned char* slab : slabs_) {
+            ::operator delete(slab, std::align_val_t(kSlabBytes));
+        }
+    }
+
+    OrderPool(const OrderPool&) = delete;
+    OrderPool& operator=(const OrderPool&) = delete;
+
+    Order* acquire(OrderId id, Price price, Quantity quantity, Side side) {
+        if (free_list_ == nullptr) add_slab();
+
+        Slot* slot = free_list_;
+        free_list_ = slot->next_free;
+        if (++in_use_ > high_water_mark_) high_water_mark_ = in_use_;
+
+        Order* order = new (slot->storage) Order(id, quantity, side);
+        new (&info(order)) OrderInfo(price, quantity);
+        return order;
+    }
+
+    void release(Order* order) {
+        Slot* slot = reinterpret_cast<Slot*>(order);
+        slot->next_free = free_list_;
+        free_list_ = slot;
+        --in_use_;
+    }
+
+    OrderHandle handle_of(const Order* order) const {
+        auto addr = reinterpret_cast<uintptr_t>(order);
+        uintptr_t slab = addr & ~static_cast<uintptr_t>(kSlabBytes - 1);
+        size_t slab_no = *reinterpret_cast<const uint32_t*>(slab);
+        return static_cast<OrderHandle>(slab_no * kOrdersPerSlab + (addr - slab - kHotOffset) / sizeof(Order));
+    }
+
+    Order* at(OrderHandle handle) const {
+        Order* slab_orders = reinterpret_cast<Order*>(slabs_[handle / kOrdersPerSlab] + kHotOffset);
+        return slab_orders + handle % kOrdersPerSlab;
+    }
+
+    static OrderInfo& info(Order* order) {
+        auto addr = reinterpret_cast<uintptr_t>(order);
+        uintptr_t slab = addr & ~static_cast<uintptr_t>(kSlabBytes - 1);
+        size_t index = (addr - slab - kHotOffset) / sizeof(Order);
+        return reinterpret_cast<OrderInfo*>(slab + kColdOffset)[index];
+    }
+
+    size_t capacity() const {
+        return slabs_.size() * kOrdersPerSlab;
+    }
+
+    OrderPoolStats stats() const {
+        return OrderPoolStats{capacity(), in_use_, high_water_mark_, slabs_.size()};
+    }
+
+private:
+    void add_slab() {
+        auto* slab = static_cast<unsigned char*>(::operator new(kSlabBytes, std::align_val_t(kSlabBytes)));
+        *reinterpret_cast<uint32_t*>(slab) = static_cast<uint32_t>(slabs_.size());
+        slabs_.push_back(slab);
+        Slot* slots = reinterpret_cast<Slot*>(slab + kHotOffset);
+
+        // Thread the new slots in address order so fresh orders are allocated
+        // sequentially through the slab
+        for (size_t i = 0; i + 1 < kOrdersPerSlab; ++i) {
+            slots[i].next_free = &slots[i + 1];
+        }
+        slots[kOrdersPerSlab - 1].next_free = free_list_;
+        free_list_ = slots;
+    }
+};
+
+}
@@ -0,0 +1,229 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include <algorithm>
+#include <utility>
+#include "order.hpp"
+#include "price_level.hpp"
+#include "occupancy_bitmap.hpp"
+#include "order_pool.hpp"
+
+namespace trading {
+
+// Contiguous array of PriceLevel slots for one side of the book, indexed by
+// (price - base) / tick. The best level index is cached so the top of book is
+// a single array access, and a new level never allocates unless the price
+// falls outside the current window. An occupancy bitmap finds the next
+// populated level when the best one empties. Every resting order's OrderInfo
+// points back at its level, so removal needs no price lookup.
+template<Side S>
+class PriceLadder {
+public:
+    static constexpr size_t kInitialLevels = 1024;
+    static constexpr size_t kDefaultMaxLevels = size_t(1) << 20;
+
+private:
+    std::vector<PriceLevel> levels_;
+    OccupancyBitmap occupied_;  // Bit i set iff levels_[i] is non-empty
+    Price base_;                // Price of levels_[0]
+    Price tick_;                // Price distance between neighbouring slots
+    size_t max_levels_;         // Hard cap on the window, bounds memory per side
+    size_t best_;               // Index of the best non-empty level (valid if level_count_ > 0)
+    size_t level_count_;        // Number of non-empty levels
+
+public:
+    explicit PriceLadder(Price tick_size = 1, size_t max_levels = kDefaultMaxLevels)
+        : base_(0)
+        , tick_(tick_size)
+        , max_levels_(std::max(max_levels, kInitialLevels))
+        , best_(0)
+        , level_count_(0)
+    {}
+
+    bool empty() const {
+        return level_count_ == 0;
+    }
+
+    size_t level_count() const {
+        return level_count_;
+    }
+
+    Price tick_size() const {
+        return tick_;
+    }
+
+    Price best_price() const {
+        return empty() ? 0 : levels_[best_].get_price();
+    }
+
+    PriceLevel& best_level() {
+        return levels_[best_];
+    }
+
+    // True if a taker with this limit price is marketable against this side
+    bool crosses(Price limit) const {
+        if (empty()) return false;
+        return S == Side::BUY ? limit <= best_price() : limit >= best_price();
+    }
+
+    // Resting quantity a taker with this limit could reach, summed level by
+    // level from the best price outward. Stops early once `wanted` is reached;
+    // individual orders are never visited.
+    uint64_t quantity_up_to(Price limit, uint64_t wanted) const {
+        uint64_t total = 0;
+        size_t i = empty() ? OccupancyBitmap::npos : best_;
+        while (i != OccupancyBitmap::npos && total < wanted) {
+            const PriceLevel& level = levels_[i];
+            bool marketable = S == Side::BUY ? limit <= level.get_price() : limit >= level.get_price();
+            if (!marketable) break;
+            total += level.get_total_quantity();
+            if (S == Side::BUY) {
+                i = i > 0 ? occupied_.find_prev(i - 1) : OccupancyBitmap::npos;
+            } else {
+                i = occupied_.find_next(i + 1);
+            }
+        }
+        return total;
+    }
+
+    bool on_grid(Price price) const { return tick_ != 0 && price % tick_ == 0; }
+
+    // True if an order at this price can rest on this side without the window
+    // growing beyond max_levels_
+    bool can_hold(Price price) const {
+        if (!on_grid(price)) return false;
+        if (empty() || in_window(price)) return true;
+
+        Price lo = std::min(price, levels_[lowest_index()].get_price());
+        Price hi = std::max(price, levels_[highest_index()].get_price());
+        return (hi - lo) / tick_ < max_levels_;
+    }
+
+    // Level for a price that is already on this side, nullptr if absent
+    PriceLevel* find(Price price) {
+        if (!in_window(price)) return nullptr;
+        PriceLevel& level = levels_[index_of(price)];
+        return level.is_empty() ? nullptr : &level;
+    }
+
+    void add_order(Order* order, Price price) {
+        ensure_window(price);
+        size_t idx = index_of(price);
+        PriceLevel& level = levels_[idx];
+
+        if (level.is_empty()) {
+            if (level_count_ == 0 || is_better(idx, best_)) best_ = idx;
+            ++level_count_;
+            occupied_.set(idx);
+        }
+        level.add_order(order);
+        OrderPool::info(order).level = &level;
+    }
+
+    void remove_order(Order* order) {
+        PriceLevel* level = OrderPool::info(order).level;
+        level->remove_order(order);
+        if (level->is_empty()) on_level_emptied(static_cast<size_t>(level - levels_.data()));
+    }
+
+    // Called by the matcher once it has drained the best level
+    void pop_best() {
+        on_level_emptied(best_);
+    }
+
+    // Visit non-empty levels from the highest price to the lowest
+    template<typename F>
+    void for_each_descending(F&& f) const {
+        size_t i = occupied_.last();
+        while (i != OccupancyBitmap::npos) {
+            f(levels_[i]);
+            if (i == 0) break;
+            i = occupied_.find_prev(i - 1);
+        }
+    }
+
+private:
+    bool in_window(Price price) const {
+        return !levels_.empty() && price >= base_ && (price - base_) / tick_ < levels_.size();
+    }
+
+    size_t index_of(Price price) const {
+        return static_cast<size_t>((price - base_) / tick_);
+    }
+
+    static bool is_better(size_t a, size_t b) {
+        return S == Side::BUY ? a > b : a < b;
+    }
+
+    size_t lowest_index() const {
+        return S == Side::SELL ? best_ : occupied_.first();
+    }
+
+    size_t highest_index() const {
+        return S == Side::BUY ? best_ : occupied_.last();
+    }
+
+    void on_level_emptied(size_t idx) {
+        --level_count_;
+        occupied_.clear(idx);
+        if (level_count_ == 0 || idx != best_) return;
+
+        // Next populated level away from the touch
+        best_ = (S == Side::BUY) ? occupied_.find_prev(idx) : occupied_.find_next(idx);
+    }
+
+    // Make sure price maps to a slot, re-centring an empty ladder or growing a
+    // populated one. Callers are expected to have checked can_hold().
+    void ensure_window(Price price) {
+        if (in_window(price)) return;
+
+        if (empty()) {
+            size_t size = std::max(levels_.size(), kInitialLevels);
+            rebuild(price, price, size);
+            return;
+        }
+
+        Price lo = std::min(price, levels_[lowest_index()].get_price());
+        Price hi = std::max(price, levels_[highest_index()].get_price());
+        size_t needed = static_cast<size_t>((hi - lo) / tick_) + 1;
+        size_t size = std::min(std::max(levels_.size() * 2, needed), max_levels_);
+        rebuild(lo, hi, size);
+    }
+
+    // Reallocate to `size` slots covering [lo, hi] with the slack split evenly
+    // on both sides, carrying over every populated level
+    void rebuild(Price lo, Price hi, size_t size) {
+        size_t span = static_cast<size_t>((hi - lo) / tick_) + 1;
+        Price slack = static_cast<Price>((size - span) / 2) * tick_;
+        Price new_base = lo >= slack ? lo - slack : 0;
+
+        std::vector<PriceLevel> levels;
+        levels.reserve(size);
+        for (size_t i = 0; i < size; ++i) {
+            levels.emplace_back(new_base + static_cast<Price>(i) * tick_);
+        }
+
+        OccupancyBitmap occupied(size);
+        for (size_t i = occupied_.first(); i != OccupancyBitmap::npos; i = occupied_.find_next(i + 1)) {
+            size_t idx = static_cast<size_t>((levels_[i].get_price() - new_base) / tick_);
+            levels[idx] = levels_[i];
+            occupied.set(idx);
+        }
+
+        if (!empty()) {
+            best_ = static_cast<size_t>((levels_[best_].get_price() - new_base) / tick_);
+        }
+        levels_.swap(levels);
+
+        // Levels moved, so re-point their orders
+        for (size_t i = occupied.first(); i != OccupancyBitmap::npos; i = occupied.find_next(i + 1)) {
+            for (Order* order = levels_[i].get_head(); order != nullptr; order = order->next) {
+                OrderPool::info(order).level = &levels_[i];
+            }
+        }
+        occupied_ = std::move(occupied);
+        base_ = new_base;
+    }
+};
+
+}
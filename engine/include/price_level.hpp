@@ -69,6 +69,12 @@ public:
     void update_quantity(Quantity filled) {
         total_quantity_ -= filled;
     }
+    
+    // Shrink a resting order without touching its place in the queue
+    void reduce_order(Order* order, Quantity new_remaining) {
+        total_quantity_ -= order->remaining - new_remaining;
+        order->remaining = new_remaining;
+    }
 };
 
 } 
\ No newline at end of file
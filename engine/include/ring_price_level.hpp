@@ -0,0 +1,140 @@
+#pragma once
+#include <vector>
+#include <cstddef>
+#include "order.hpp"
+#include "order_pool.hpp"
+
+namespace trading {
+
+// Alternative to PriceLevel that keeps the FIFO queue as a contiguous ring of
+// 32-bit OrderHandles instead of threading Order::next/prev. Walking the queue
+// is a linear scan the hardware prefetcher can follow, and the next orders'
+// addresses are known without waiting on the current one.
+//
+// Cancels are lazy: the order's remaining quantity is zeroed to mark it as a
+// tombstone and its slot is left in the ring. The level owns tombstoned
+// orders and returns them to the pool when the head walks past them or when
+// a compaction squeezes them out, so a handle in the ring never refers to a
+// recycled slot.
+class RingPriceLevel {
+public:
+    static constexpr size_t kInitialCapacity = 16;
+    static constexpr size_t kMinCompactSize = 64;  // Smaller rings are never compacted early
+
+private:
+    Price price_;
+    Quantity total_quantity_;         // Sum of live remaining quantities
+    std::vector<OrderHandle> slots_;  // Capacity is a power of two
+    size_t head_;                     // Position of the oldest entry
+    size_t tail_;                     // Position one past the newest entry
+    size_t tombstones_;               // Cancelled entries still in [head_, tail_)
+
+public:
+    explicit RingPriceLevel(Price price)
+        : price_(price)
+        , total_quantity_(0)
+        , head_(0)
+        , tail_(0)
+        , tombstones_(0)
+    {}
+
+    Price get_price() const {
+        return price_;
+    }
+
+    Quantity get_total_quantity() const {
+        return total_quantity_;
+    }
+
+    size_t order_count() const {
+        return tail_ - head_ - tombstones_;
+    }
+
+    bool is_empty() const {
+        return order_count() == 0;
+    }
+
+    void add_order(Order* order, OrderPool& pool) {
+        if (tail_ - head_ == slots_.size()) grow(pool);
+        slots_[tail_++ & mask()] = pool.handle_of(order);
+        total_quantity_ += order->remaining_quantity();
+    }
+
+    // Oldest live order, releasing any tombstones in front of it
+    Order* get_head(OrderPool& pool) {
+        while (head_ != tail_) {
+            Order* order = pool.at(slots_[head_ & mask()]);
+            if (!order->is_fully_filled()) return order;
+            pool.release(order);
+            ++head_;
+            --tombstones_;
+        }
+        return nullptr;
+    }
+
+    // Drop the head once the matcher has filled it; the caller releases it
+    void pop_head() {
+        ++head_;
+    }
+
+    void update_quantity(Quantity filled) {
+        total_quantity_ -= filled;
+    }
+
+    // Tombstone a resting order. The level takes ownership of its pool slot.
+    void cancel_order(Order* order, OrderPool& pool) {
+        total_quantity_ -= order->remaining_quantity();
+        order->remaining = 0;
+        ++tombstones_;
+
+        size_t size = tail_ - head_;
+        if (tombstones_ == size || (size >= kMinCompactSize && tombstones_ * 2 > size)) {
+            compact(pool);
+        }
+    }
+
+    // Release every tombstone and pack the live handles up behind the head,
+    // preserving arrival order
+    void compact(OrderPool& pool) {
+        size_t out = head_;
+        for (size_t pos = head_; pos != tail_; ++pos) {
+            OrderHandle handle = slots_[pos & mask()];
+            Order* order = pool.at(handle);
+            if (order->is_fully_filled()) {
+                pool.release(order);
+            } else {
+                slots_[out++ & mask()] = handle;  // out <= pos, so writes never overtake reads
+            }
+        }
+        tail_ = out;
+        tombstones_ = 0;
+    }
+
+private:
+    size_t mask() const {
+        return slots_.size() - 1;
+    }
+
+    void grow(OrderPool& pool) {
+        if (tombstones_ > 0) {
+            // Reclaiming tombstones may free enough room
+            compact(pool);
+            if (tail_ - head_ < slots_.size()) return;
+        }
+        unwrap(slots_.empty() ? kInitialCapacity : slots_.size() * 2);
+    }
+
+    // Copy entries into a fresh buffer of `capacity` in queue order from index 0
+    void unwrap(size_t capacity) {
+        std::vector<OrderHandle> slots(capacity);
+        size_t count = tail_ - head_;
+        for (size_t i = 0; i < count; ++i) {
+            slots[i] = slots_[(head_ + i) & mask()];
+        }
+        slots_.swap(slots);
+        head_ = 0;
+        tail_ = count;
+    }
+};
+
+}
@@ -0,0 +1,145 @@
+#pragma once
+#include <atomic>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include "thread_affinity.hpp"
+
+namespace trading {
+
+// Progress of one producer or consumer stage over a SequenceRing: the highest
+// sequence it has finished with, -1 before the first. Padded to its own cache
+// line since every stage polls the ones it follows.
+struct alignas(64) Sequence {
+    std::atomic<int64_t> value{-1};
+
+    int64_t get() const { return value.load(std::memory_order_acquire); }
+    void set(int64_t sequence) { value.store(sequence, std::memory_order_release); }
+};
+
+// Preallocated ring of events in the style of the LMAX Disruptor. Producers
+// claim a sequence, fill the slot in place and publish it; consumer stages
+// walk the same slots in sequence order behind a SequenceBarrier, each
+// tracking its progress in its own Sequence. Nothing is copied between
+// stages and no stage takes a lock: a stage only ever reads slots that every
+// stage ahead of it has released, and producers never lap the slowest stage
+// registered with add_gating_sequence(). Capacity is rounded up to a power of
+// two.
+template<typename T>
+class SequenceRing {
+public:
+    explicit SequenceRing(size_t capacity)
+        : capacity_(round_up(capacity))
+        , mask_(capacity_ - 1)
+        , slots_(new T[capacity_]())
+        , published_(new std::atomic<int64_t>[capacity_])
+    {
+        for (size_t i = 0; i < capacity_; ++i) {
+            published_[i].store(-1, std::memory_order_relaxed);
+        }
+    }
+
+    SequenceRing(const SequenceRing&) = delete;
+    SequenceRing& operator=(const SequenceRing&) = delete;
+
+    // A stage producers must not lap. Register every tail stage before the
+    // first claim.
+    void add_gating_sequence(const Sequence& sequence) {
+        gating_.push_back(&sequence);
+    }
+
+    // Any thread. Claims the next sequence, waiting while the ring is full.
+    int64_t claim() {
+        int64_t sequence = next_.fetch_add(1, std::memory_order_relaxed);
+        int64_t wrap_point = sequence - static_cast<int64_t>(capacity_);
+        if (wrap_point > gating_cache_.load(std::memory_order_relaxed)) {
+            IdleBackoff backoff(true);
+            int64_t slowest;
+            while (wrap_point > (slowest = min_gating())) backoff.pause();
+            gating_cache_.store(slowest, std::memory_order_relaxed);
+        }
+        return sequence;
+    }
+
+    T& operator[](int64_t sequence) { return slots_[sequence & mask_]; }
+    const T& operator[](int64_t sequence) const { return slots_[sequence & mask_]; }
+
+    // Make a claimed and filled slot visible to the stages
+    void publish(int64_t sequence) {
+        published_[sequence & mask_].store(sequence, std::memory_order_release);
+    }
+
+    // Highest sequence claimed so far; producers may still be filling the
+    // later ones
+    int64_t claimed() const {
+        return next_.load(std::memory_order_acquire) - 1;
+    }
+
+    // Producers publish out of order; this is the end of the unbroken run of
+    // published slots starting at `from`, or from - 1 if `from` isn't out yet
+    int64_t highest_published(int64_t from, int64_t upto) const {
+        for (int64_t sequence = from; sequence <= upto; ++sequence) {
+            if (published_[sequence & mask_].load(std::memory_order_acquire) != sequence) {
+                return sequence - 1;
+            }
+        }
+        return upto;
+    }
+
+    size_t capacity() const { return capacity_; }
+
+private:
+    int64_t min_gating() const {
+        int64_t slowest = next_.load(std::memory_order_relaxed) - 1;
+        for (const Sequence* sequence : gating_) {
+            slowest = std::min(slowest, sequence->get());
+        }
+        return slowest;
+    }
+
+    static size_t round_up(size_t n) {
+        size_t capacity = 2;
+        while (capacity < n) capacity <<= 1;
+        return capacity;
+    }
+
+    const size_t capacity_;
+    const size_t mask_;
+    std::unique_ptr<T[]> slots_;
+    std::unique_ptr<std::atomic<int64_t>[]> published_;  // Sequence last published into each slot
+    std::vector<const Sequence*> gating_;
+    alignas(64) std::atomic<int64_t> next_{0};            // Next sequence to claim, shared by producers
+    alignas(64) std::atomic<int64_t> gating_cache_{-1};   // Slowest gating stage as last seen by a producer
+};
+
+// What a consumer stage may read: published slots, no further than the
+// stages it follows. A stage waits for one sequence and then drains every
+// slot up to the returned one as a batch, so a stage that falls behind
+// catches up in large strides instead of one handoff per event.
+template<typename T>
+class SequenceBarrier {
+public:
+    // With no dependencies the stage follows the producers directly
+    SequenceBarrier(const SequenceRing<T>& ring, std::vector<const Sequence*> dependencies = {})
+        : ring_(ring), dependencies_(std::move(dependencies)) {}
+
+    // Highest sequence the stage may process, or next - 1 if none yet
+    int64_t available(int64_t next) const {
+        if (dependencies_.empty()) {
+            return ring_.highest_published(next, ring_.claimed());
+        }
+        int64_t upto = dependencies_[0]->get();
+        for (size_t i = 1; i < dependencies_.size(); ++i) {
+            upto = std::min(upto, dependencies_[i]->get());
+        }
+        return upto;
+    }
+
+private:
+    const SequenceRing<T>& ring_;
+    std::vector<const Sequence*> dependencies_;
+};
+
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <vector>
+#include <deque>
+#include <memory>
+#include <unordered_map>
+#include <cstdint>
+#include "order_book.hpp"
+
+namespace trading {
+
+using SymbolId = uint32_t;
+
+// Interned instruments and their order books. Symbols get dense IDs in the
+// order they are added, so routing an order is an index into books_; names
+// are only hashed where they enter the system (request parsing, symbol
+// lookups). Books are created empty and allocate order storage on their
+// first order, so an idle instrument costs little more than the OrderBook
+// object itself.
+//
+// Every symbol must be added before the directory is shared between
+// threads; from then on it is read-only.
+//
+// Order IDs handed to clients carry the symbol in their top bits over the
+// book's own dense ID, so a cancel or amend finds its book without a symbol
+// field. Symbol 0's IDs are exactly its book's IDs.
+class SymbolDirectory {
+public:
+    static constexpr SymbolId kNoSymbol = UINT32_MAX;
+    static constexpr unsigned kLocalIdBits = 40;
+    static constexpr OrderId kLocalIdMask = (OrderId(1) << kLocalIdBits) - 1;
+    static constexpr size_t kMaxSymbols = size_t(1) << (64 - kLocalIdBits);
+    static constexpr size_t kMaxNameLength = 16;
+
+private:
+    std::vector<std::unique_ptr<OrderBook>> books_;
+    std::deque<std::string> names_;   // A deque, so ids_'s keys never move
+    std::unordered_map<std::string_view, SymbolId> ids_;   // Keys view names_
+
+public:
+    SymbolDirectory() = default;
+
+    SymbolDirectory(const SymbolDirectory&) = delete;
+    SymbolDirectory& operator=(const SymbolDirectory&) = delete;
+
+    // Intern `name` with a new book, or return its existing ID. Returns
+    // kNoSymbol for an empty or over-long name or a full directory.
+    // order_capacity preallocates order storage; 0 defers it to the first
+    // order.
+    SymbolId add(std::string_view name, size_t order_capacity = 0);
+
+    SymbolId find(std::string_view name) const;
+
+    bool contains(SymbolId symbol) const { return symbol < books_.size(); }
+    size_t size() const { return books_.size(); }
+    const std::string& name(SymbolId symbol) const { return names_[symbol]; }
+
+    OrderBook& book(SymbolId symbol) { return *books_[symbol]; }
+    const OrderBook& book(SymbolId symbol) const { return *books_[symbol]; }
+
+    static OrderId to_global(SymbolId symbol, OrderId local_id) {
+        return local_id == 0 ? 0 : (static_cast<OrderId>(symbol) << kLocalIdBits) | local_id;
+    }
+    static SymbolId symbol_of(OrderId order_id) {
+        return static_cast<SymbolId>(order_id >> kLocalIdBits);
+    }
+    static OrderId local_id(OrderId order_id) {
+        return order_id & kLocalIdMask;
+    }
+};
+
+}
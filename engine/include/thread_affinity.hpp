@@ -0,0 +1,62 @@
+#pragma once
+#include <thread>
+#include <chrono>
+
+#ifdef __linux__
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace trading {
+
+// Pin the calling thread to one CPU. Returns false where unsupported or
+// when the CPU is not available to this process.
+inline bool pin_current_thread(int cpu) {
+#ifdef __linux__
+    if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return pthread_setaffinity_np(pthread_self(), sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+inline void cpu_relax() {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__)
+    asm volatile("yield");
+#endif
+}
+
+// Polling backoff: spin briefly, then yield the core, then (unless told to
+// keep spinning) sleep in short naps so an idle poller costs next to nothing
+class IdleBackoff {
+public:
+    explicit IdleBackoff(bool never_sleep = false) : never_sleep_(never_sleep) {}
+
+    void reset() { rounds_ = 0; }
+
+    void pause() {
+        if (rounds_ < kSpinRounds) {
+            cpu_relax();
+        } else if (rounds_ < kYieldRounds || never_sleep_) {
+            std::this_thread::yield();
+        } else {
+            std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+        if (rounds_ < kYieldRounds) ++rounds_;
+    }
+
+private:
+    static constexpr unsigned kSpinRounds = 64;
+    static constexpr unsigned kYieldRounds = 4096;
+
+    unsigned rounds_ = 0;
+    bool never_sleep_;
+};
+
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <vector>
+#include <string>
+#include <cstddef>
+#include <cstdint>
+#include "order.hpp"
+
+namespace trading {
+
+using TradeSeq = uint64_t;
+
+struct TradeRecord {
+    TradeSeq sequence;
+    Trade trade;
+};
+
+// Bounded history of executed trades. The most recent trades live in a
+// fixed-capacity ring; once it wraps, each overwritten record is appended to a
+// memory-mapped spill file if one is open, and dropped otherwise. Sequence
+// numbers start at 1 and are dense, so a record's position in the ring and in
+// the spill file follows directly from its sequence.
+class TradeJournal {
+public:
+    static constexpr size_t kDefaultCapacity = size_t(1) << 14;
+    static constexpr size_t kSpillWindowRecords = size_t(1) << 16;  // Records mapped at a time
+
+private:
+    std::vector<TradeRecord> ring_;  // Allocated on first append
+    size_t capacity_;
+    TradeSeq next_seq_;
+
+    // Spill file state
+    std::string spill_path_;
+    int spill_fd_;
+    TradeRecord* window_;      // Mapped window being appended to
+    TradeSeq window_first_;    // Sequence stored in window_[0]
+    TradeSeq spilled_;         // Records 1..spilled_ are on disk
+
+public:
+    explicit TradeJournal(size_t capacity = kDefaultCapacity);
+    ~TradeJournal();
+
+    TradeJournal(const TradeJournal&) = delete;
+    TradeJournal& operator=(const TradeJournal&) = delete;
+
+    // Start spilling overwritten records to `path`, truncating any previous
+    // contents. Returns false if the file cannot be created or mapped, or if
+    // records have already been dropped. Should the file later fail to grow,
+    // spilling stops: the file keeps what it has, and history reverts to
+    // what the ring holds.
+    bool open_spill_file(const std::string& path);
+
+    TradeSeq append(const Trade& trade) {
+        if (ring_.empty()) ring_.resize(capacity_);
+
+        TradeRecord& slot = ring_[next_seq_ & (capacity_ - 1)];
+        if (next_seq_ > capacity_ && spill_fd_ >= 0) spill(slot);
+
+        slot.sequence = next_seq_;
+        slot.trade = trade;
+        return next_seq_++;
+    }
+
+    size_t capacity() const { return capacity_; }
+    TradeSeq next_sequence() const { return next_seq_; }
+    TradeSeq last_sequence() const { return next_seq_ - 1; }
+    const std::string& spill_path() const { return spill_path_; }
+
+    // Oldest sequence still retrievable, from the ring or the spill file
+    TradeSeq first_available() const;
+
+    // Up to n most recent trades, oldest first
+    std::vector<TradeRecord> last(size_t n) const;
+
+    // Trades with sequence >= seq, oldest first, at most max_count of them
+    std::vector<TradeRecord> since(TradeSeq seq, size_t max_count = SIZE_MAX) const;
+
+private:
+    TradeSeq ring_first() const {
+        return next_seq_ > capacity_ ? next_seq_ - capacity_ : 1;
+    }
+
+    void spill(const TradeRecord& record);
+    bool map_window(TradeSeq first);
+    bool read_spilled(TradeSeq seq, TradeRecord& out) const;
+    void close_spill_file();
+};
+
+}
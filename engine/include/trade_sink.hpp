@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include "order.hpp"
+
+namespace trading {
+
+// Trade sink over caller-owned storage, for use with the sink overload of
+// OrderBook::add_order. Trades past capacity still happen; they are counted
+// but not stored, and overflowed() reports it.
+class TradeSpanSink {
+private:
+    Trade* data_;
+    size_t capacity_;
+    size_t count_;
+
+public:
+    TradeSpanSink(Trade* data, size_t capacity)
+        : data_(data), capacity_(capacity), count_(0) {}
+
+    template<size_t N>
+    explicit TradeSpanSink(Trade (&data)[N])
+        : TradeSpanSink(data, N) {}
+
+    void operator()(const Trade& trade) {
+        if (count_ < capacity_) data_[count_] = trade;
+        ++count_;
+    }
+
+    const Trade* begin() const { return data_; }
+    const Trade* end() const { return data_ + size(); }
+    size_t size() const { return count_ < capacity_ ? count_ : capacity_; }
+    size_t total() const { return count_; }
+    bool overflowed() const { return count_ > capacity_; }
+    void clear() { count_ = 0; }
+};
+
+}
@@ -0,0 +1,187 @@
+#include "../include/binary_client.hpp"
+#include <algorithm>
+#include <cstring>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #define close closesocket
+#else
+    #include <unistd.h>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+    #include <netdb.h>
+#endif
+
+namespace trading {
+
+using namespace wire;
+
+BinaryClient::~BinaryClient() { disconnect(); }
+
+bool BinaryClient::connect(const std::string& host, int port) {
+    disconnect();
+
+    addrinfo hints{};
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    addrinfo* addresses = nullptr;
+    if (getaddrinfo(host.c_str(), std::to_string(port).c_str(), &hints, &addresses) != 0) return false;
+
+    for (addrinfo* a = addresses; a != nullptr && socket_ < 0; a = a->ai_next) {
+        int fd = static_cast<int>(socket(a->ai_family, a->ai_socktype, a->ai_protocol));
+        if (fd < 0) continue;
+        if (::connect(fd, a->ai_addr, static_cast<int>(a->ai_addrlen)) == 0) {
+            int opt = 1;
+            setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, (const char*)&opt, sizeof(opt));
+            socket_ = fd;
+        } else {
+            close(fd);
+        }
+    }
+    freeaddrinfo(addresses);
+    return socket_ >= 0;
+}
+
+void BinaryClient::disconnect() {
+    if (socket_ >= 0) {
+        close(socket_);
+        socket_ = -1;
+    }
+    buffer_.clear();
+    buffer_offset_ = 0;
+}
+
+OrderEntry BinaryClient::limit(Price price, Quantity quantity, Side side, TimeInForce tif) {
+    return OrderEntry{price, quantity, UINT32_MAX, static_cast<uint8_t>(side),
+                      static_cast<uint8_t>(OrderType::LIMIT), static_cast<uint8_t>(tif), 0};
+}
+
+OrderEntry BinaryClient::market(Quantity quantity, Side side, uint32_t protection_ticks) {
+    return OrderEntry{0, quantity, protection_ticks, static_cast<uint8_t>(side),
+                      static_cast<uint8_t>(OrderType::MARKET), static_cast<uint8_t>(TimeInForce::IOC), 0};
+}
+
+bool BinaryClient::new_order(uint32_t symbol, const OrderEntry& order, ExecutionReport& report, std::vector<Fill>& fills) {
+    NewOrder message{header_for<NewOrder>(MessageType::NEW_ORDER), next_tag_++, symbol, order};
+    request_.clear();
+    append_message(request_, message);
+
+    fills.clear();
+    if (!send_all(request_) || !expect(MessageType::EXECUTION_REPORT, sizeof(ExecutionReport))) return false;
+    report = read_message<ExecutionReport>(message_.data());
+    return read_fills(report.fill_count, fills);
+}
+
+bool BinaryClient::new_order_batch(uint32_t symbol, const std::vector<OrderEntry>& orders,
+                                   std::vector<ExecutionReport>& reports, std::vector<Fill>& fills) {
+    size_t entries = orders.size() * sizeof(OrderEntry);
+    NewOrderBatch message{header_for<NewOrderBatch>(MessageType::NEW_ORDER_BATCH, entries), next_tag_++,
+                          symbol, static_cast<uint16_t>(orders.size()), 0};
+    request_.clear();
+    append_message(request_, message);
+    request_.append(reinterpret_cast<const char*>(orders.data()), entries);
+
+    reports.clear();
+    fills.clear();
+    if (!send_all(request_)) return false;
+    for (size_t i = 0; i < orders.size(); ++i) {
+        if (!expect(MessageType::EXECUTION_REPORT, sizeof(ExecutionReport))) return false;
+        reports.push_back(read_message<ExecutionReport>(message_.data()));
+        if (!read_fills(reports.back().fill_count, fills)) return false;
+    }
+    return true;
+}
+
+bool BinaryClient::cancel(OrderId order_id, CancelReport& report) {
+    Cancel message{header_for<Cancel>(MessageType::CANCEL), next_tag_++, order_id};
+    request_.clear();
+    append_message(request_, message);
+
+    if (!send_all(request_) || !expect(MessageType::CANCEL_REPORT, sizeof(CancelReport))) return false;
+    report = read_message<CancelReport>(message_.data());
+    return true;
+}
+
+bool BinaryClient::amend(OrderId order_id, Price price, Quantity quantity,
+                         AmendReport& report, std::vector<Fill>& fills) {
+    Amend message{header_for<Amend>(MessageType::AMEND), next_tag_++, order_id, price, quantity};
+    request_.clear();
+    append_message(request_, message);
+
+    fills.clear();
+    if (!send_all(request_) || !expect(MessageType::AMEND_REPORT, sizeof(AmendReport))) return false;
+    report = read_message<AmendReport>(message_.data());
+    return read_fills(report.fill_count, fills);
+}
+
+bool BinaryClient::lookup_symbol(const std::string& name, SymbolReport& report) {
+    SymbolLookup message{header_for<SymbolLookup>(MessageType::SYMBOL_LOOKUP), next_tag_++, {}};
+    std::memcpy(message.name, name.data(), std::min(name.size(), sizeof(message.name)));
+    request_.clear();
+    append_message(request_, message);
+
+    if (!send_all(request_) || !expect(MessageType::SYMBOL_REPORT, sizeof(SymbolReport))) return false;
+    report = read_message<SymbolReport>(message_.data());
+    return true;
+}
+
+bool BinaryClient::send_all(const std::string& data) {
+    size_t sent = 0;
+    while (sent < data.size()) {
+        auto n = send(socket_, data.data() + sent, static_cast<int>(data.size() - sent), 0);
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+bool BinaryClient::receive_message() {
+    while (true) {
+        size_t available = buffer_.size() - buffer_offset_;
+        if (available >= sizeof(MessageHeader)) {
+            MessageHeader header = read_message<MessageHeader>(buffer_.data() + buffer_offset_);
+            if (header.length < sizeof(MessageHeader)) return false;
+            if (available >= header.length) {
+                message_.assign(buffer_, buffer_offset_, header.length);
+                buffer_offset_ += header.length;
+                return true;
+            }
+        }
+
+        // Compact, then read more
+        buffer_.erase(0, buffer_offset_);
+        buffer_offset_ = 0;
+        char chunk[1024 * 16];
+        auto n = recv(socket_, chunk, sizeof(chunk), 0);
+        if (n <= 0) return false;
+        buffer_.append(chunk, static_cast<size_t>(n));
+    }
+}
+
+bool BinaryClient::expect(MessageType type, size_t size) {
+    last_reject_ = RejectReason::NONE;
+    while (receive_message()) {
+        MessageHeader header = read_message<MessageHeader>(message_.data());
+        if (header.type == type) return message_.size() >= size;
+        if (header.type == MessageType::REJECT && message_.size() >= sizeof(Reject)) {
+            last_reject_ = read_message<Reject>(message_.data()).reason;
+            return false;
+        }
+    }
+    return false;
+}
+
+bool BinaryClient::read_fills(uint32_t count, std::vector<Fill>& fills) {
+    for (uint32_t i = 0; i < count; ++i) {
+        if (!expect(MessageType::FILL, sizeof(Fill))) return false;
+        fills.push_back(read_message<Fill>(message_.data()));
+    }
+    return true;
+}
+
+}
@@ -0,0 +1,468 @@
+#include "../include/binary_server.hpp"
+#include "../include/logger.hpp"
+#include <algorithm>
+
+#ifdef _WIN32
+    #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+    #endif
+    #include <winsock2.h>
+    #include <ws2tcpip.h>
+    #define close closesocket
+#else
+    #include <unistd.h>
+    #include <fcntl.h>
+    #include <cerrno>
+    #include <sys/socket.h>
+    #include <netinet/in.h>
+    #include <netinet/tcp.h>
+#endif
+
+#ifdef __linux__
+    #include <sys/epoll.h>
+#endif
+
+namespace trading {
+
+using namespace wire;
+
+namespace {
+
+// Field checks matching what the HTTP API enforces on the same order
+RejectReason validate_entry(const OrderEntry& entry, OrderRequest& req) {
+    if (entry.type > static_cast<uint8_t>(OrderType::MARKET)) return RejectReason::INVALID_TYPE;
+    bool is_market = entry.type == static_cast<uint8_t>(OrderType::MARKET);
+
+    if (!is_market && (entry.price == 0 || entry.price > kMaxPrice)) return RejectReason::INVALID_PRICE;
+    if (entry.quantity == 0 || entry.quantity > kMaxQuantity) return RejectReason::INVALID_QUANTITY;
+    if (entry.side > static_cast<uint8_t>(Side::SELL)) return RejectReason::INVALID_SIDE;
+    if (entry.time_in_force > static_cast<uint8_t>(TimeInForce::FOK)) return RejectReason::INVALID_TIME_IN_FORCE;
+    // Market orders never rest and make no full-fill check: IOC only
+    if (is_market && entry.time_in_force != static_cast<uint8_t>(TimeInForce::IOC)) return RejectReason::INVALID_TIME_IN_FORCE;
+    if (!is_market && entry.protection_ticks != OrderBook::kUnprotected) return RejectReason::INVALID_PROTECTION;
+
+    req = OrderRequest{
+        is_market ? 0 : entry.price,
+        entry.quantity,
+        static_cast<Side>(entry.side),
+        static_cast<OrderType>(entry.type),
+        static_cast<TimeInForce>(entry.time_in_force),
+        entry.protection_ticks
+    };
+    return RejectReason::NONE;
+}
+
+void append_reject(std::string& out, uint64_t client_tag, MessageType type, RejectReason reason) {
+    Reject reject{header_for<Reject>(MessageType::REJECT), client_tag, type, reason, {}};
+    append_message(out, reject);
+}
+
+// Every request carries its client_tag right after the header; 0 when the
+// message is too short to hold one
+uint64_t client_tag_of(const char* data, size_t length) {
+    uint64_t tag = 0;
+    if (length >= sizeof(MessageHeader) + sizeof(tag)) {
+        std::memcpy(&tag, data + sizeof(MessageHeader), sizeof(tag));
+    }
+    return tag;
+}
+
+void append_fill(std::string& out, uint64_t client_tag, const Trade& trade) {
+    Fill fill{header_for<Fill>(MessageType::FILL), client_tag,
+              trade.buyer_id, trade.seller_id, trade.price, trade.quantity};
+    append_message(out, fill);
+}
+
+#ifdef __linux__
+constexpr int kMaxEvents = 256;
+constexpr int kPollIntervalMs = 500;  // How often stop() is noticed
+
+bool set_non_blocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+#endif
+
+}
+
+BinaryServer::BinaryServer(int port, MatchingEngine::Gateway& engine, const BinaryServerConfig& config)
+    : port_(port), server_socket_(-1), epoll_fd_(-1), running_(false), engine_(engine), config_(config) {}
+
+BinaryServer::~BinaryServer() { stop(); }
+
+void BinaryServer::start() {
+#ifdef __linux__
+    server_socket_ = socket(AF_INET, SOCK_STREAM, 0);
+    int opt = 1;
+    setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+
+    struct sockaddr_in address;
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = INADDR_ANY;
+    address.sin_port = htons(port_);
+
+    if (bind(server_socket_, (struct sockaddr*)&address, sizeof(address)) < 0) {
+        LOG_ERROR("Binary listener bind failed on port {}", port_);
+        return;
+    }
+
+    listen(server_socket_, config_.backlog);
+    running_ = true;
+    LOG_INFO("Binary order entry listening on port {}", port_);
+    run_event_loop();
+#else
+    LOG_ERROR("Binary order entry needs epoll; listener on port {} not started", port_);
+#endif
+}
+
+void BinaryServer::stop() {
+    if (running_.exchange(false)) {
+        close(server_socket_);
+    }
+}
+
+#ifdef __linux__
+// ============================================================
+// EVENT LOOP: same shape as HttpServer's, framing on the length
+// prefix instead of HTTP headers
+// ============================================================
+void BinaryServer::run_event_loop() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0 || !set_non_blocking(server_socket_)) {
+        LOG_ERROR("Binary event loop setup failed: errno {}", errno);
+        return;
+    }
+
+    epoll_event listen_event{};
+    listen_event.events = EPOLLIN | EPOLLET;
+    listen_event.data.fd = server_socket_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, server_socket_, &listen_event);
+
+    std::vector<epoll_event> events(kMaxEvents);
+    while (running_) {
+        int ready = epoll_wait(epoll_fd_, events.data(), kMaxEvents, kPollIntervalMs);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR("epoll_wait failed: errno {}", errno);
+            break;
+        }
+
+        for (int i = 0; i < ready && running_; ++i) {
+            int fd = events[i].data.fd;
+            uint32_t flags = events[i].events;
+            if (fd == server_socket_) {
+                accept_connections();
+                continue;
+            }
+
+            auto it = connections_.find(fd);
+            if (it == connections_.end()) continue;
+
+            bool keep = !(flags & EPOLLERR);
+            if (keep && (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) keep = on_readable(fd, it->second);
+            if (keep && (flags & EPOLLOUT)) keep = serve(fd, it->second);
+            if (!keep) close_connection(fd);
+        }
+    }
+
+    while (!connections_.empty()) close_connection(connections_.begin()->first);
+    close(epoll_fd_);
+    epoll_fd_ = -1;
+}
+
+void BinaryServer::accept_connections() {
+    while (true) {
+        int fd = accept4(server_socket_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            return;
+        }
+
+        // Replies are small and latency-bound: never hold them back for Nagle
+        int opt = 1;
+        setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+        connections_[fd] = BinaryConnection();
+    }
+}
+
+// Returns false when the connection should be closed
+bool BinaryServer::on_readable(int fd, BinaryConnection& conn) {
+    if (!read_input(fd, conn)) return false;
+    return serve(fd, conn);
+}
+
+// As in HttpServer: drain the socket unless replies are backing up or
+// enough is buffered already, leaving the rest in the kernel until serve()
+// catches up. Returns false when the connection should be closed.
+bool BinaryServer::read_input(int fd, BinaryConnection& conn) {
+    char buffer[1024 * 16];
+    conn.input_paused = false;
+    while (true) {
+        if (conn.out.size() - conn.out_offset >= kMaxPendingOutput || conn.in.size() >= kMaxBufferedInput) {
+            conn.input_paused = true;
+            return true;
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            conn.in.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if (n == 0) {
+            conn.peer_closed = true;
+            return true;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+        return false;
+    }
+}
+
+bool BinaryServer::serve(int fd, BinaryConnection& conn) {
+    while (true) {
+        bool framed = process_messages(conn);
+        bool throttled = conn.out.size() - conn.out_offset >= kMaxPendingOutput;
+        if (!flush(fd, conn)) return false;
+        if (!framed) return false;
+        if (!conn.out.empty()) return true;  // Resume on EPOLLOUT
+        // As in HttpServer: no EPOLLOUT edge follows a complete write and
+        // paused input raises no EPOLLIN edge, so resume here
+        if (conn.input_paused) {
+            if (!read_input(fd, conn)) return false;
+            continue;
+        }
+        if (throttled) continue;
+        // A peer that hung up is answered in full before the close
+        return !conn.peer_closed;
+    }
+}
+
+// Returns false when the stream can no longer be framed
+bool BinaryServer::process_messages(BinaryConnection& conn) {
+    size_t consumed = 0;
+    bool framed = true;
+    while (conn.out.size() - conn.out_offset < kMaxPendingOutput) {
+        size_t available = conn.in.size() - consumed;
+        if (available < sizeof(MessageHeader)) break;
+
+        const char* data = conn.in.data() + consumed;
+        MessageHeader header = read_message<MessageHeader>(data);
+        if (header.length < sizeof(MessageHeader)) {
+            append_reject(conn.out, 0, header.type, RejectReason::MALFORMED_MESSAGE);
+            framed = false;
+            break;
+        }
+        if (available < header.length) break;
+        consumed += header.length;
+
+        // The header is the same in every version, so the stream stays
+        // framed; the body layout may not be, so the message is refused
+        if (header.version != kVersion) {
+            append_reject(conn.out, client_tag_of(data, header.length), header.type, RejectReason::UNSUPPORTED_VERSION);
+            continue;
+        }
+
+        switch (header.type) {
+            case MessageType::NEW_ORDER: handle_new_order(data, header.length, conn.out); break;
+            case MessageType::NEW_ORDER_BATCH: handle_new_order_batch(data, header.length, conn.out); break;
+            case MessageType::CANCEL: handle_cancel(data, header.length, conn.out); break;
+            case MessageType::AMEND: handle_amend(data, header.length, conn.out); break;
+            case MessageType::SYMBOL_LOOKUP: handle_symbol_lookup(data, header.length, conn.out); break;
+            default:
+                append_reject(conn.out, client_tag_of(data, header.length), header.type, RejectReason::UNKNOWN_MESSAGE);
+        }
+    }
+    conn.in.erase(0, consumed);
+    return framed;
+}
+
+bool BinaryServer::flush(int fd, BinaryConnection& conn) {
+    while (conn.out_offset < conn.out.size()) {
+        ssize_t n = send(fd, conn.out.data() + conn.out_offset, conn.out.size() - conn.out_offset, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.out_offset += static_cast<size_t>(n);
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;  // Resume on EPOLLOUT
+        return false;
+    }
+    conn.out.clear();
+    conn.out_offset = 0;
+    return true;
+}
+
+void BinaryServer::close_connection(int fd) {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections_.erase(fd);
+}
+#endif
+
+// ============================================================
+// MESSAGE HANDLERS
+// ============================================================
+void BinaryServer::handle_new_order(const char* data, size_t length, std::string& out) {
+    if (length != sizeof(NewOrder)) {
+        append_reject(out, client_tag_of(data, length), MessageType::NEW_ORDER, RejectReason::MALFORMED_MESSAGE);
+        return;
+    }
+    NewOrder message = read_message<NewOrder>(data);
+    enter_orders(message.client_tag, message.symbol, data + offsetof(NewOrder, order), 1, out);
+}
+
+void BinaryServer::handle_new_order_batch(const char* data, size_t length, std::string& out) {
+    if (length < sizeof(NewOrderBatch)) {
+        append_reject(out, client_tag_of(data, length), MessageType::NEW_ORDER_BATCH, RejectReason::MALFORMED_MESSAGE);
+        return;
+    }
+    NewOrderBatch message = read_message<NewOrderBatch>(data);
+    if (length != sizeof(NewOrderBatch) + message.count * sizeof(OrderEntry)) {
+        append_reject(out, message.client_tag, MessageType::NEW_ORDER_BATCH, RejectReason::MALFORMED_MESSAGE);
+        return;
+    }
+    if (message.count > kMaxBatchOrders) {
+        append_reject(out, message.client_tag, MessageType::NEW_ORDER_BATCH, RejectReason::BATCH_TOO_LARGE);
+        return;
+    }
+    enter_orders(message.client_tag, message.symbol, data + sizeof(NewOrderBatch), message.count, out);
+}
+
+void BinaryServer::enter_orders(uint64_t client_tag, SymbolId symbol, const char* entries, size_t count, std::string& out) {
+    bool known_symbol = engine_.symbols().contains(symbol);
+    requests_.clear();
+    reasons_.resize(count);
+    for (size_t i = 0; i < count; ++i) {
+        OrderRequest req;
+        reasons_[i] = known_symbol ? validate_entry(read_message<OrderEntry>(entries + i * sizeof(OrderEntry)), req)
+                                   : RejectReason::UNKNOWN_SYMBOL;
+        if (reasons_[i] == RejectReason::NONE) requests_.push_back(req);
+    }
+
+    // add_orders turns an order the ladder can't hold into a REJECTED
+    // result instead of throwing, for one order as for many
+    if (!requests_.empty()) {
+        try {
+            engine_.add_orders(symbol, requests_, results_);
+        } catch (const EngineHalted&) {
+            for (RejectReason& reason : reasons_) {
+                if (reason == RejectReason::NONE) reason = RejectReason::ENGINE_HALTED;
+            }
+        }
+    }
+    const std::vector<Trade>& trades = engine_.trades();
+
+    // As in POST /orders, each order's fills are the run of trades that
+    // name it as the taker, which is always the higher of the two ids
+    size_t next_trade = 0;
+    size_t next_result = 0;
+    for (size_t i = 0; i < count; ++i) {
+        ExecutionReport report{header_for<ExecutionReport>(MessageType::EXECUTION_REPORT), client_tag,
+                               0, 0, 0, 0, static_cast<uint8_t>(OrderStatus::REJECTED), reasons_[i], {}};
+        if (reasons_[i] != RejectReason::NONE) {
+            append_message(out, report);
+            continue;
+        }
+
+        const OrderResult& result = results_[next_result++];
+        size_t first_trade = next_trade;
+        while (result.order_id != 0 && next_trade < trades.size() &&
+               std::max(trades[next_trade].buyer_id, trades[next_trade].seller_id) == result.order_id) {
+            ++next_trade;
+        }
+
+        report.order_id = result.order_id;
+        report.filled_quantity = result.filled_quantity;
+        report.resting_quantity = result.resting_quantity;
+        report.fill_count = static_cast<uint32_t>(next_trade - first_trade);
+        report.status = static_cast<uint8_t>(result.status);
+        if (result.status == OrderStatus::REJECTED) report.reason = RejectReason::BOOK_REJECTED;
+        append_message(out, report);
+        for (size_t t = first_trade; t < next_trade; ++t) append_fill(out, client_tag, trades[t]);
+    }
+}
+
+void BinaryServer::handle_cancel(const char* data, size_t length, std::string& out) {
+    if (length != sizeof(Cancel)) {
+        append_reject(out, client_tag_of(data, length), MessageType::CANCEL, RejectReason::MALFORMED_MESSAGE);
+        return;
+    }
+    Cancel message = read_message<Cancel>(data);
+
+    bool cancelled;
+    try {
+        cancelled = engine_.cancel_order(message.order_id);
+    } catch (const EngineHalted&) {
+        append_reject(out, message.client_tag, MessageType::CANCEL, RejectReason::ENGINE_HALTED);
+        return;
+    }
+
+    CancelReport report{header_for<CancelReport>(MessageType::CANCEL_REPORT), message.client_tag,
+                        message.order_id, static_cast<uint8_t>(cancelled), {}};
+    append_message(out, report);
+}
+
+void BinaryServer::handle_amend(const char* data, size_t length, std::string& out) {
+    if (length != sizeof(Amend)) {
+        append_reject(out, client_tag_of(data, length), MessageType::AMEND, RejectReason::MALFORMED_MESSAGE);
+        return;
+    }
+    Amend message = read_message<Amend>(data);
+
+    AmendReport report{header_for<AmendReport>(MessageType::AMEND_REPORT), message.client_tag,
+                       message.order_id, 0, 0, RejectReason::NONE, {}};
+    if (message.price == 0 || message.price > kMaxPrice) {
+        report.reason = RejectReason::INVALID_PRICE;
+    } else if (message.quantity == 0 || message.quantity > kMaxQuantity) {
+        report.reason = RejectReason::INVALID_QUANTITY;
+    }
+    if (report.reason != RejectReason::NONE) {
+        append_message(out, report);
+        return;
+    }
+
+    try {
+        report.amended = engine_.amend_order(message.order_id, message.price, message.quantity);
+    } catch (const EngineHalted&) {
+        report.reason = RejectReason::ENGINE_HALTED;
+        append_message(out, report);
+        return;
+    } catch (const std::out_of_range&) {
+        // Thrown before the order is touched, as for add_order
+        report.reason = RejectReason::BOOK_REJECTED;
+        append_message(out, report);
+        return;
+    }
+
+    const std::vector<Trade>& trades = engine_.trades();
+    report.fill_count = static_cast<uint32_t>(trades.size());
+    append_message(out, report);
+    for (const Trade& trade : trades) append_fill(out, message.client_tag, trade);
+}
+
+void BinaryServer::handle_symbol_lookup(const char* data, size_t length, std::string& out) {
+    if (length != sizeof(SymbolLookup)) {
+        append_reject(out, client_tag_of(data, length), MessageType::SYMBOL_LOOKUP, RejectReason::MALFORMED_MESSAGE);
+        return;
+    }
+    SymbolLookup message = read_message<SymbolLookup>(data);
+    std::string_view name(message.name, strnlen(message.name, sizeof(message.name)));
+    SymbolId symbol = engine_.symbols().find(name);
+
+    SymbolReport report{header_for<SymbolReport>(MessageType::SYMBOL_REPORT), message.client_tag,
+                        0, 0, {}};
+    if (symbol != SymbolDirectory::kNoSymbol) {
+        report.symbol = symbol;
+        report.found = 1;
+    }
+    append_message(out, report);
+}
+
+}
@@ -0,0 +1,159 @@
+#include "../include/http_parser.hpp"
+#include <cstdio>
+
+namespace trading {
+
+namespace {
+
+bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        char x = a[i], y = b[i];
+        if (x >= 'A' && x <= 'Z') x = static_cast<char>(x - 'A' + 'a');
+        if (y >= 'A' && y <= 'Z') y = static_cast<char>(y - 'A' + 'a');
+        if (x != y) return false;
+    }
+    return true;
+}
+
+bool icontains(std::string_view haystack, std::string_view needle) {
+    for (size_t i = 0; i + needle.size() <= haystack.size(); ++i) {
+        if (iequals(haystack.substr(i, needle.size()), needle)) return true;
+    }
+    return false;
+}
+
+std::string_view trim(std::string_view s) {
+    while (!s.empty() && (s.front() == ' ' || s.front() == '\t')) s.remove_prefix(1);
+    while (!s.empty() && (s.back() == ' ' || s.back() == '\t' || s.back() == '\r')) s.remove_suffix(1);
+    return s;
+}
+
+// Split off the text up to `delim`, leaving the rest in `s`
+std::string_view take_until(std::string_view& s, char delim) {
+    size_t pos = s.find(delim);
+    std::string_view token = s.substr(0, pos);
+    s.remove_prefix(pos == std::string_view::npos ? s.size() : pos + 1);
+    return token;
+}
+
+}
+
+HttpParser::HttpParser(size_t max_body_bytes)
+    : max_body_bytes_(max_body_bytes)
+{
+    // Formatted once here so a rejected request costs no formatting
+    const char* unit = "bytes";
+    size_t amount = max_body_bytes;
+    if (amount >= (1 << 20) && amount % (1 << 20) == 0) {
+        amount >>= 20;
+        unit = "MiB";
+    } else if (amount >= (1 << 10) && amount % (1 << 10) == 0) {
+        amount >>= 10;
+        unit = "KiB";
+    }
+    std::snprintf(too_large_body_, sizeof(too_large_body_), "{\"error\":\"Request body too large (max: %zu %s)\"}",
+                  amount, unit);
+    reset();
+}
+
+std::string_view HttpRequest::header(std::string_view name) const {
+    for (size_t i = 0; i < header_count; ++i) {
+        if (iequals(headers[i].name, name)) return headers[i].value;
+    }
+    return {};
+}
+
+HttpParser::Status HttpParser::parse(const char* data, size_t size, HttpRequest& request) {
+    if (header_length_ == 0) {
+        // Look for the blank line, resuming just before where the last
+        // search stopped in case the terminator straddles two reads
+        size_t from = scanned_ >= 3 ? scanned_ - 3 : 0;
+        size_t limit = size < kMaxHeaderBytes ? size : kMaxHeaderBytes;
+        for (size_t i = from; i < limit; ++i) {
+            if (data[i] != '\n') continue;
+            if (i >= 1 && data[i - 1] == '\n') {
+                header_length_ = i + 1;
+                break;
+            }
+            if (i >= 2 && data[i - 1] == '\r' && data[i - 2] == '\n') {
+                header_length_ = i + 1;
+                break;
+            }
+        }
+
+        if (header_length_ == 0) {
+            scanned_ = limit;
+            if (size >= kMaxHeaderBytes) {
+                return fail(400, "{\"error\":\"Request headers too large (max: 8 KiB)\"}");
+            }
+            return Status::INCOMPLETE;
+        }
+    } else if (size < request_length()) {
+        return Status::INCOMPLETE;  // Head already checked, body still arriving
+    }
+
+    Status head = parse_head(data, request);
+    if (head != Status::COMPLETE) return head;
+    if (size < header_length_ + content_length_) return Status::INCOMPLETE;
+
+    request.body = std::string_view(data + header_length_, content_length_);
+    return Status::COMPLETE;
+}
+
+// Split the request line and headers and read Content-Length. Runs once when
+// the blank line is found and again when a late body completes, since the
+// buffer may have moved in between.
+HttpParser::Status HttpParser::parse_head(const char* data, HttpRequest& request) {
+    std::string_view head(data, header_length_);
+
+    std::string_view request_line = trim(take_until(head, '\n'));
+    request.method = take_until(request_line, ' ');
+    request.path = take_until(request_line, ' ');
+    request.version = trim(request_line);
+    if (request.method.empty() || request.path.empty() || request.version.substr(0, 5) != "HTTP/") {
+        return fail(400, "{\"error\":\"Malformed request line\"}");
+    }
+
+    request.header_count = 0;
+    while (!head.empty()) {
+        std::string_view line = trim(take_until(head, '\n'));
+        if (line.empty()) break;
+
+        size_t colon = line.find(':');
+        if (colon == std::string_view::npos) {
+            return fail(400, "{\"error\":\"Malformed header\"}");
+        }
+        if (request.header_count == HttpRequest::kMaxHeaders) {
+            return fail(400, "{\"error\":\"Too many headers (max: 32)\"}");
+        }
+        request.headers[request.header_count++] = HttpHeader{trim(line.substr(0, colon)), trim(line.substr(colon + 1))};
+    }
+
+    if (!request.header("Transfer-Encoding").empty()) {
+        return fail(501, "{\"error\":\"Transfer-Encoding is not supported; send Content-Length\"}");
+    }
+
+    content_length_ = 0;
+    std::string_view length = request.header("Content-Length");
+    for (char c : length) {
+        if (c < '0' || c > '9') {
+            return fail(400, "{\"error\":\"Invalid Content-Length\"}");
+        }
+        content_length_ = content_length_ * 10 + static_cast<size_t>(c - '0');
+        if (content_length_ > max_body_bytes_) {
+            return fail(413, too_large_body_);
+        }
+    }
+
+    // Persistent by default on HTTP/1.1, opt-in on 1.0
+    std::string_view connection = request.header("Connection");
+    if (request.version == "HTTP/1.1") {
+        request.keep_alive = !icontains(connection, "close");
+    } else {
+        request.keep_alive = icontains(connection, "keep-alive");
+    }
+    return Status::COMPLETE;
+}
+
+}
@@ -1,12 +1,17 @@
 #include "../include/http_server.hpp"
 #include "../include/nlohmann/json.hpp"
 #include "../include/order.hpp" 
+#include "../include/logger.hpp"
+#include "../include/order_decoder.hpp"
+#include "../include/json_writer.hpp"
 #include <iostream>
-#include <sstream>
 #include <cstring>
+#include <charconv>
+#include <iterator>
 #include <vector>
 #include <algorithm>
 #include <cmath> 
+#include <cstdlib>
 
 
 #ifdef _WIN32
@@ -19,17 +24,364 @@
     #define close closesocket
 #else
     #include <unistd.h>
+    #include <fcntl.h>
+    #include <cerrno>
     #include <sys/socket.h>
     #include <netinet/in.h>
     #include <arpa/inet.h>
 #endif
 
+#ifdef __linux__
+    #include <sys/epoll.h>
+    #include <sys/uio.h>
+#endif
+
 using json = nlohmann::json;
 
 namespace trading {
 
-HttpServer::HttpServer(int port, OrderBook& book)
-    : port_(port), server_socket_(-1), running_(false), order_book_(book) {}
+namespace {
+
+// ============================================================
+// CLEAR PRICE LOGIC: Always expect dollars (e.g., 100.50)
+// Internally convert to cents (10050)
+// Returns an empty string on success, else the error body
+// ============================================================
+std::string parse_price_field(const json& value, Price& price) {
+    if (!value.is_number()) {
+        return "{\"error\":\"Price must be a number\"}";
+    }
+    
+    double price_dollars = value.get<double>();
+    
+    // Validate range
+    if (price_dollars <= 0.0) {
+        return "{\"error\":\"Price must be positive\"}";
+    }
+    if (price_dollars > 1000000.0) {
+        return "{\"error\":\"Price too large (max: $1,000,000)\"}";
+    }
+    
+    // Convert to cents exactly as the fast decoder would, from the shortest
+    // text that reads back as this double (1.005 stays 1.005, not 1.00499...)
+    char text[32];
+    auto printed = std::to_chars(text, text + sizeof(text), price_dollars);
+    decimal_to_cents(std::string_view(text, static_cast<size_t>(printed.ptr - text)), price);
+    return "";
+}
+
+// ============================================================
+// QUANTITY VALIDATION
+// ============================================================
+std::string parse_quantity_field(const json& value, Quantity& quantity) {
+    if (!value.is_number_unsigned()) {
+        return "{\"error\":\"Quantity must be a positive integer\"}";
+    }
+    
+    // Range-check before narrowing so 2^32 + 1 can't wrap to 1
+    uint64_t requested = value.get<uint64_t>();
+    
+    if (requested == 0) {
+        return "{\"error\":\"Quantity must be greater than 0\"}";
+    }
+    if (requested > 1000000) {
+        return "{\"error\":\"Quantity too large (max: 1,000,000)\"}";
+    }
+    quantity = static_cast<Quantity>(requested);
+    return "";
+}
+
+// ============================================================
+// ORDER FIELDS: shared by POST /order and each entry of POST /orders
+// Returns an empty string on success, else the error body
+// ============================================================
+std::string parse_order_fields(const json& j, OrderRequest& req) {
+    // ============================================================
+    // ORDER TYPE (optional, defaults to LIMIT)
+    // ============================================================
+    OrderType type = OrderType::LIMIT;
+    if (j.contains("type")) {
+        if (!j["type"].is_string()) {
+            return "{\"error\":\"type must be a string\"}";
+        }
+        
+        std::string type_str = j["type"].get<std::string>();
+        std::transform(type_str.begin(), type_str.end(), type_str.begin(), ::toupper);
+        
+        if (type_str == "LIMIT") {
+            type = OrderType::LIMIT;
+        } else if (type_str == "MARKET") {
+            type = OrderType::MARKET;
+        } else {
+            return "{\"error\":\"type must be 'LIMIT' or 'MARKET'\"}";
+        }
+    }
+    bool is_market = type == OrderType::MARKET;
+
+    // Strict validation; a market order carries no price
+    if ((!is_market && !j.contains("price")) || !j.contains("quantity") || !j.contains("side")) {
+        json err;
+        err["error"] = "Missing required fields";
+        err["required"] = is_market ? json{"quantity", "side"} : json{"price", "quantity", "side"};
+        err["received"] = j;
+        return err.dump();
+    }
+
+    Price price = 0;
+    std::string error;
+    if (!is_market) {
+        error = parse_price_field(j["price"], price);
+        if (!error.empty()) {
+            return error;
+        }
+    }
+    
+    Quantity quantity;
+    error = parse_quantity_field(j["quantity"], quantity);
+    if (!error.empty()) {
+        return error;
+    }
+    
+    // ============================================================
+    // SIDE VALIDATION
+    // ============================================================
+    if (!j["side"].is_string()) {
+        return "{\"error\":\"Side must be a string\"}";
+    }
+    
+    std::string side_str = j["side"].get<std::string>();
+    
+    // Convert to uppercase for case-insensitive matching
+    std::transform(side_str.begin(), side_str.end(), side_str.begin(), ::toupper);
+    
+    Side side;
+    if (side_str == "BUY") {
+        side = Side::BUY;
+    } else if (side_str == "SELL") {
+        side = Side::SELL;
+    } else {
+        return "{\"error\":\"Side must be 'BUY' or 'SELL'\"}";
+    }
+
+    // ============================================================
+    // TIME IN FORCE (optional, defaults to GTC)
+    // ============================================================
+    TimeInForce tif = TimeInForce::GTC;
+    if (j.contains("time_in_force")) {
+        if (!j["time_in_force"].is_string()) {
+            return "{\"error\":\"time_in_force must be a string\"}";
+        }
+        
+        std::string tif_str = j["time_in_force"].get<std::string>();
+        std::transform(tif_str.begin(), tif_str.end(), tif_str.begin(), ::toupper);
+        
+        if (tif_str == "GTC") {
+            tif = TimeInForce::GTC;
+        } else if (tif_str == "IOC") {
+            tif = TimeInForce::IOC;
+        } else if (tif_str == "FOK") {
+            tif = TimeInForce::FOK;
+        } else {
+            return "{\"error\":\"time_in_force must be 'GTC', 'IOC' or 'FOK'\"}";
+        }
+    }
+
+    // ============================================================
+    // MARKET PROTECTION (optional, in ticks through the opposite best)
+    // ============================================================
+    uint32_t protection_ticks = OrderBook::kUnprotected;
+    if (j.contains("protection_ticks")) {
+        if (!is_market) {
+            return "{\"error\":\"protection_ticks only applies to MARKET orders\"}";
+        }
+        if (!j["protection_ticks"].is_number_unsigned() ||
+            j["protection_ticks"].get<uint64_t>() >= OrderBook::kUnprotected) {
+            return "{\"error\":\"protection_ticks must be a non-negative integer\"}";
+        }
+        protection_ticks = j["protection_ticks"].get<uint32_t>();
+    }
+    if (is_market) {
+        // Market orders never rest, so the remainder is always cancelled.
+        // IOC is the only time in force they take; a FOK would need a
+        // full-fill check the market path does not make.
+        if (j.contains("time_in_force") && tif != TimeInForce::IOC) {
+            return "{\"error\":\"MARKET orders only take time_in_force 'IOC'\"}";
+        }
+        tif = TimeInForce::IOC;
+    }
+
+    req = OrderRequest{price, quantity, side, type, tif, protection_ticks};
+    return "";
+}
+
+// ============================================================
+// SYMBOL: "symbol" names the instrument, by name or by numeric
+// symbol ID; without one an order goes to the default symbol (ID 0)
+// Returns an empty string on success, else the error body
+// ============================================================
+std::string resolve_symbol(const SymbolDirectory& symbols, const SymbolField& field, SymbolId& symbol) {
+    switch (field.kind) {
+        case SymbolField::NONE:
+            symbol = 0;
+            break;
+        case SymbolField::NAME:
+            symbol = symbols.find(field.name);
+            break;
+        case SymbolField::ID:
+            symbol = field.id < symbols.size() ? static_cast<SymbolId>(field.id) : SymbolDirectory::kNoSymbol;
+            break;
+    }
+    if (symbol != SymbolDirectory::kNoSymbol) {
+        return "";
+    }
+
+    json err;
+    err["error"] = "Unknown symbol";
+    if (field.kind == SymbolField::NAME) {
+        err["symbol"] = std::string(field.name);
+    } else {
+        err["symbol"] = field.id;
+    }
+    return err.dump();
+}
+
+std::string parse_symbol_field(const SymbolDirectory& symbols, const json& j, SymbolId& symbol) {
+    SymbolField field;
+    if (j.contains("symbol")) {
+        const json& value = j["symbol"];
+        if (value.is_string()) {
+            field.kind = SymbolField::NAME;
+            field.name = value.get_ref<const std::string&>();
+        } else if (value.is_number_unsigned() && value.get<uint64_t>() <= UINT32_MAX) {
+            field.kind = SymbolField::ID;
+            field.id = value.get<uint64_t>();
+        } else {
+            return "{\"error\":\"symbol must be a symbol name or a numeric symbol id\"}";
+        }
+    }
+    return resolve_symbol(symbols, field, symbol);
+}
+
+// Value of `key` in the target's query string
+bool query_param(std::string_view target, std::string_view key, std::string_view& value) {
+    size_t pos = target.find('?');
+    while (pos != std::string_view::npos) {
+        std::string_view param = target.substr(pos + 1);
+        param = param.substr(0, param.find('&'));
+        if (param.size() > key.size() && param.compare(0, key.size(), key) == 0 && param[key.size()] == '=') {
+            value = param.substr(key.size() + 1);
+            return true;
+        }
+        pos = target.find('&', pos + 1);
+    }
+    return false;
+}
+
+// ?symbol= on a GET, by name or else by numeric ID; the default symbol
+// when absent, kNoSymbol when unknown
+SymbolId query_symbol(const SymbolDirectory& symbols, std::string_view target) {
+    std::string_view value;
+    if (!query_param(target, "symbol", value)) {
+        return 0;
+    }
+    SymbolId symbol = symbols.find(value);
+    if (symbol != SymbolDirectory::kNoSymbol) {
+        return symbol;
+    }
+    uint64_t id;
+    auto result = std::from_chars(value.data(), value.data() + value.size(), id);
+    if (result.ec == std::errc() && result.ptr == value.data() + value.size() && id < symbols.size()) {
+        return static_cast<SymbolId>(id);
+    }
+    return SymbolDirectory::kNoSymbol;
+}
+
+// Exact path, or the path followed by a query string
+bool route_matches(std::string_view target, std::string_view path) {
+    return target.compare(0, path.size(), path) == 0 && (target.size() == path.size() || target[path.size()] == '?');
+}
+
+const char* const kUnknownSymbol = "{\"error\":\"Unknown symbol\"}";
+const char* const kEngineHalted = "{\"error\":\"Engine halted: input journal failed\"}";
+
+json trade_to_json(const Trade& trade) {
+    return {
+        {"buyer_id", trade.buyer_id},
+        {"seller_id", trade.seller_id},
+        {"price", trade.price / 100.0},      // Convert back to dollars for display
+        {"price_cents", trade.price},        // Also show cents for debugging
+        {"quantity", trade.quantity}
+    };
+}
+
+// Same fields as trade_to_json, written straight to the response body.
+// Keys stay in the sorted order json::dump() uses so clients see no change.
+void write_trade(JsonWriter& w, const Trade& trade) {
+    w.begin_object()
+        .field("buyer_id", trade.buyer_id)
+        .key("price").price(trade.price)
+        .field("price_cents", trade.price)
+        .field("quantity", trade.quantity)
+        .field("seller_id", trade.seller_id)
+        .end_object();
+}
+
+// ============================================================
+// RESPONSE HEADERS: one precomputed template per status and
+// connection mode; only Content-Length is formatted per response
+// ============================================================
+constexpr int kStatusCodes[] = {200, 400, 404, 413, 500, 501, 503};
+
+const char* status_text(int status_code) {
+    switch (status_code) {
+        case 200: return "OK";
+        case 400: return "Bad Request";
+        case 404: return "Not Found";
+        case 413: return "Payload Too Large";
+        case 500: return "Internal Server Error";
+        case 501: return "Not Implemented";
+        case 503: return "Service Unavailable";
+        default: return "Unknown";
+    }
+}
+
+std::string make_head_template(int status_code, bool keep_alive) {
+    std::string head = "HTTP/1.1 " + std::to_string(status_code) + " " + status_text(status_code) + "\r\n";
+    head += "Content-Type: application/json\r\n";
+    head += "Access-Control-Allow-Origin: *\r\n";
+    head += keep_alive ? "Connection: keep-alive\r\n" : "Connection: close\r\n";
+    head += "Content-Length: ";
+    return head;
+}
+
+void append_response_head(std::string& out, int status_code, size_t content_length, bool keep_alive) {
+    static const auto templates = [] {
+        std::vector<std::string> all;
+        for (int code : kStatusCodes) {
+            all.push_back(make_head_template(code, false));
+            all.push_back(make_head_template(code, true));
+        }
+        return all;
+    }();
+
+    size_t index = 0;
+    while (index < std::size(kStatusCodes) && kStatusCodes[index] != status_code) ++index;
+    if (index < std::size(kStatusCodes)) {
+        out += templates[index * 2 + (keep_alive ? 1 : 0)];
+    } else {
+        out += make_head_template(status_code, keep_alive);
+    }
+
+    char digits[24];
+    char* end = std::to_chars(digits, digits + sizeof(digits), content_length).ptr;
+    out.append(digits, static_cast<size_t>(end - digits));
+    out += "\r\n\r\n";
+}
+
+}
+
+HttpServer::HttpServer(int port, MatchingEngine::Gateway& engine, const HttpServerConfig& config)
+    : port_(port), server_socket_(-1), epoll_fd_(-1), running_(false), engine_(engine), config_(config) {}
 
 HttpServer::~HttpServer() { stop(); }
 
@@ -42,6 +394,12 @@ void HttpServer::start() {
     server_socket_ = socket(AF_INET, SOCK_STREAM, 0);
     int opt = 1;
     setsockopt(server_socket_, SOL_SOCKET, SO_REUSEADDR, (const char*)&opt, sizeof(opt));
+#ifdef SO_REUSEPORT
+    if (config_.reuse_port) {
+        // The kernel spreads new connections across every loop on the port
+        setsockopt(server_socket_, SOL_SOCKET, SO_REUSEPORT, (const char*)&opt, sizeof(opt));
+    }
+#endif
     
     struct sockaddr_in address;
     address.sin_family = AF_INET;
@@ -49,14 +407,18 @@ void HttpServer::start() {
     address.sin_port = htons(port_);
     
     if (bind(server_socket_, (struct sockaddr*)&address, sizeof(address)) < 0) {
-        std::cerr << "Bind failed" << std::endl;
+        LOG_ERROR("Bind failed on port {}", port_);
         return;
     }
     
-    listen(server_socket_, 10);
+    listen(server_socket_, config_.backlog);
     running_ = true;
-    std::cout << "🚀 Server listening on port " << port_ << std::endl;
+    LOG_INFO("🚀 Server listening on port {} (backlog {})", port_, config_.backlog);
     
+#ifdef __linux__
+    run_event_loop();
+#else
+    // No epoll here: serve one connection at a time
     while (running_) {
         struct sockaddr_in client_addr;
 #ifdef _WIN32
@@ -70,11 +432,11 @@ void HttpServer::start() {
             close(client_socket);
         }
     }
+#endif
 }
 
 void HttpServer::stop() {
-    if (running_) {
-        running_ = false;
+    if (running_.exchange(false)) {
         close(server_socket_);
 #ifdef _WIN32
         WSACleanup();
@@ -88,47 +450,269 @@ void HttpServer::handle_connection(int client_socket) {
     if (bytes_read <= 0) return;
 
     std::string request_raw(buffer, bytes_read);
-    HttpRequest request = parse_request(request_raw);
-    HttpResponse response = route_request(request);
-    std::string response_str = build_response(response);
+
+    // Batches outgrow one read: keep reading until Content-Length is met
+    HttpParser parser;
+    HttpRequest request;
+    HttpParser::Status status;
+    while ((status = parser.parse(request_raw.data(), request_raw.size(), request)) == HttpParser::Status::INCOMPLETE) {
+        bytes_read = recv(client_socket, buffer, sizeof(buffer), 0);
+        if (bytes_read <= 0) return;
+        request_raw.append(buffer, bytes_read);
+    }
+    HttpResponse response = status == HttpParser::Status::COMPLETE
+        ? route_request(request)
+        : HttpResponse(parser.error_status(), parser.error_body());
+    std::string response_str;
+    append_response_head(response_str, response.status_code, response.body.size(), false);
+    response_str += response.body;
     
     send(client_socket, response_str.c_str(), (int)response_str.length(), 0);
 }
 
-HttpRequest HttpServer::parse_request(const std::string& request_str) {
-    HttpRequest request;
-    
-    // Split Header and Body
-    size_t body_pos = request_str.find("\r\n\r\n");
-    if (body_pos == std::string::npos) body_pos = request_str.find("\n\n");
-
-    if (body_pos != std::string::npos) {
-        // Headers
-        std::string header_section = request_str.substr(0, body_pos);
-        std::istringstream iss(header_section);
-        iss >> request.method >> request.path;
-
-        // Body: Find the first '{' and last '}' to strip socket junk
-        std::string raw_body = request_str.substr(body_pos);
-        size_t first_brace = raw_body.find('{');
-        size_t last_brace = raw_body.rfind('}');
-        
-        if (first_brace != std::string::npos && last_brace != std::string::npos) {
-            request.body = raw_body.substr(first_brace, last_brace - first_brace + 1);
+#ifdef __linux__
+// ============================================================
+// EVENT LOOP: edge-triggered epoll over non-blocking sockets, so a
+// slow client only holds up its own connection
+// ============================================================
+namespace {
+
+constexpr int kMaxEvents = 256;
+constexpr int kPollIntervalMs = 500;  // How often stop() and idle connections are noticed
+
+bool set_non_blocking(int fd) {
+    int flags = fcntl(fd, F_GETFL, 0);
+    return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+}
+
+void HttpServer::run_event_loop() {
+    epoll_fd_ = epoll_create1(EPOLL_CLOEXEC);
+    if (epoll_fd_ < 0 || !set_non_blocking(server_socket_)) {
+        LOG_ERROR("Event loop setup failed: errno {}", errno);
+        return;
+    }
+
+    epoll_event listen_event{};
+    listen_event.events = EPOLLIN | EPOLLET;
+    listen_event.data.fd = server_socket_;
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, server_socket_, &listen_event);
+
+    std::vector<epoll_event> events(kMaxEvents);
+    auto last_sweep = std::chrono::steady_clock::now();
+    while (running_) {
+        int ready = epoll_wait(epoll_fd_, events.data(), kMaxEvents, kPollIntervalMs);
+        if (ready < 0) {
+            if (errno == EINTR) continue;
+            LOG_ERROR("epoll_wait failed: errno {}", errno);
+            break;
+        }
+
+        for (int i = 0; i < ready && running_; ++i) {
+            int fd = events[i].data.fd;
+            uint32_t flags = events[i].events;
+            if (fd == server_socket_) {
+                accept_connections();
+                continue;
+            }
+
+            auto it = connections_.find(fd);
+            if (it == connections_.end()) continue;
+
+            bool keep = !(flags & EPOLLERR);
+            if (keep && (flags & (EPOLLIN | EPOLLRDHUP | EPOLLHUP))) keep = on_readable(fd, it->second);
+            if (keep && (flags & EPOLLOUT)) keep = serve(fd, it->second);
+            if (!keep) close_connection(fd);
+        }
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - last_sweep >= std::chrono::milliseconds(kPollIntervalMs)) {
+            close_idle_connections();
+            last_sweep = now;
         }
     }
-    
-    // Debug output
-    std::cout << "Method: " << request.method << ", Path: " << request.path << std::endl;
-    if (!request.body.empty()) {
-        std::cout << "Body: " << request.body << std::endl;
+
+    while (!connections_.empty()) close_connection(connections_.begin()->first);
+    close(epoll_fd_);
+    epoll_fd_ = -1;
+}
+
+void HttpServer::accept_connections() {
+    // Edge-triggered: drain the accept queue completely
+    while (true) {
+        int fd = accept4(server_socket_, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (fd < 0) {
+            if (errno == EINTR) continue;
+            // EAGAIN means the queue is empty; anything else (e.g. EMFILE)
+            // leaves the rest queued until the next wakeup
+            return;
+        }
+
+        epoll_event event{};
+        event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+        event.data.fd = fd;
+        if (epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, fd, &event) < 0) {
+            close(fd);
+            continue;
+        }
+        HttpConnection& conn = connections_[fd];
+        conn = HttpConnection();
+        conn.last_active = std::chrono::steady_clock::now();
     }
-    
-    return request;
 }
 
+// Returns false when the connection should be closed
+bool HttpServer::on_readable(int fd, HttpConnection& conn) {
+    if (!read_input(fd, conn)) return false;
+    conn.last_active = std::chrono::steady_clock::now();
+    return serve(fd, conn);
+}
+
+// Drain the socket into `in`, unless responses are backing up or enough is
+// buffered already: then the rest stays in the kernel, where TCP flow
+// control pushes back on the client, until serve() catches up. Returns false
+// when the connection should be closed.
+bool HttpServer::read_input(int fd, HttpConnection& conn) {
+    char buffer[1024 * 16];
+    conn.input_paused = false;
+    while (true) {
+        if (!conn.close_after_write &&
+            (conn.pending_output() >= kMaxPendingOutput || conn.in.size() >= kMaxBufferedInput)) {
+            conn.input_paused = true;
+            return true;
+        }
+        ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+        if (n > 0) {
+            if (!conn.close_after_write) conn.in.append(buffer, static_cast<size_t>(n));
+            continue;
+        }
+        if (n == 0) {
+            conn.peer_closed = true;
+            return true;
+        }
+        if (errno == EINTR) continue;
+        if (errno == EAGAIN || errno == EWOULDBLOCK) return true;
+        return false;
+    }
+}
+
+// Answer whatever complete requests are buffered and push the responses
+// out. Returns false when the connection should be closed.
+bool HttpServer::serve(int fd, HttpConnection& conn) {
+    while (true) {
+        process_requests(conn);
+        if (conn.peer_closed) {
+            // Finish writing what was already answered, then hang up
+            conn.close_after_write = true;
+        }
+        // Closing over unread input would reset the connection and drop the
+        // responses still in flight, so discard what was left in the kernel
+        if (conn.close_after_write && conn.input_paused && !read_input(fd, conn)) return false;
+
+        bool throttled = conn.pending_output() >= kMaxPendingOutput;
+        if (!flush(fd, conn)) return false;
+        if (conn.pending_output() > 0) return true;  // Resume on EPOLLOUT
+        // If the socket took everything there will be no EPOLLOUT edge, and
+        // input left in the kernel raises no new EPOLLIN edge, so pick up
+        // anything held back by the caps now
+        if (conn.input_paused) {
+            if (!read_input(fd, conn)) return false;
+            continue;
+        }
+        if (!throttled) return true;
+    }
+}
+
+void HttpServer::process_requests(HttpConnection& conn) {
+    size_t consumed = 0;
+    while (!conn.close_after_write && conn.pending_output() < kMaxPendingOutput) {
+        HttpRequest request;
+        HttpParser::Status status = conn.parser.parse(conn.in.data() + consumed, conn.in.size() - consumed, request);
+        if (status == HttpParser::Status::INCOMPLETE) break;
+        if (status == HttpParser::Status::ERROR) {
+            // The stream can't be re-synchronised after a bad request
+            write_response(conn, HttpResponse(conn.parser.error_status(), conn.parser.error_body()), false);
+            conn.close_after_write = true;
+            break;
+        }
+
+        consumed += conn.parser.request_length();
+        conn.parser.reset();
+        bool keep_alive = request.keep_alive && ++conn.requests_served < config_.max_requests_per_connection;
+        write_response(conn, route_request(request), keep_alive);
+        if (!keep_alive) conn.close_after_write = true;
+    }
+    conn.in.erase(0, consumed);
+}
+
+// Queue a response: its head is formatted onto `out` and its body is moved
+// into `body`. An earlier body still waiting is appended to `out` first so
+// responses stay in order.
+void HttpServer::write_response(HttpConnection& conn, HttpResponse&& response, bool keep_alive) {
+    if (!conn.body.empty()) {
+        conn.out += conn.body;
+        conn.body.clear();
+    }
+    append_response_head(conn.out, response.status_code, response.body.size(), keep_alive);
+    conn.body = std::move(response.body);
+}
+
+// Write as much pending output as the socket takes, head and body in one
+// gathered write. Returns false when the connection should be closed.
+bool HttpServer::flush(int fd, HttpConnection& conn) {
+    while (conn.pending_output() > 0) {
+        iovec parts[2];
+        msghdr message{};
+        message.msg_iov = parts;
+        if (conn.out_offset < conn.out.size()) {
+            parts[0] = {conn.out.data() + conn.out_offset, conn.out.size() - conn.out_offset};
+            parts[1] = {conn.body.data(), conn.body.size()};
+            message.msg_iovlen = conn.body.empty() ? 1 : 2;
+        } else {
+            size_t body_offset = conn.out_offset - conn.out.size();
+            parts[0] = {conn.body.data() + body_offset, conn.body.size() - body_offset};
+            message.msg_iovlen = 1;
+        }
+
+        // sendmsg rather than writev so a vanished peer can't raise SIGPIPE
+        ssize_t n = sendmsg(fd, &message, MSG_NOSIGNAL);
+        if (n > 0) {
+            conn.out_offset += static_cast<size_t>(n);
+            conn.last_active = std::chrono::steady_clock::now();
+            continue;
+        }
+        if (n < 0 && errno == EINTR) continue;
+        if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) return true;  // Resume on EPOLLOUT
+        return false;
+    }
+    conn.out.clear();
+    conn.body.clear();
+    conn.out_offset = 0;
+    return !conn.close_after_write;
+}
+
+void HttpServer::close_idle_connections() {
+    auto cutoff = std::chrono::steady_clock::now() - std::chrono::milliseconds(config_.idle_timeout_ms);
+    std::vector<int> idle;
+    for (const auto& entry : connections_) {
+        if (entry.second.last_active < cutoff) idle.push_back(entry.first);
+    }
+    for (int fd : idle) close_connection(fd);
+}
+
+void HttpServer::close_connection(int fd) {
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, fd, nullptr);
+    close(fd);
+    connections_.erase(fd);
+}
+#endif
+
 HttpResponse HttpServer::route_request(const HttpRequest& request) {
-    std::cout << "[" << request.method << "] " << request.path << std::endl;
+    LOG_INFO("[{}] {}", request.method, request.path);
+    if (!request.body.empty()) {
+        LOG_DEBUG("Body: {}", request.body);
+    }
     
     if (request.path == "/health" && request.method == "GET") {
         return handle_health_check();
@@ -136,125 +720,282 @@ HttpResponse HttpServer::route_request(const HttpRequest& request) {
     else if (request.path == "/order" && request.method == "POST") {
         return handle_place_order(request.body);
     }
-    else if (request.path == "/orderbook" && request.method == "GET") {
-        return handle_get_orderbook();
+    else if (request.path == "/orders" && request.method == "POST") {
+        return handle_place_orders(request.body);
+    }
+    else if (route_matches(request.path, "/orderbook") && request.method == "GET") {
+        return handle_get_orderbook(request.path);
     }
-    else if (request.path == "/stats" && request.method == "GET") {
-        return handle_get_stats();
+    else if (route_matches(request.path, "/stats/all") && request.method == "GET") {
+        return handle_get_engine_stats();
+    }
+    else if (route_matches(request.path, "/stats") && request.method == "GET") {
+        return handle_get_stats(request.path);
+    }
+    else if (request.path == "/symbols" && request.method == "GET") {
+        return handle_get_symbols();
     }
     else if (request.path == "/order" && request.method == "DELETE") {
         return handle_cancel_order(request.body);
     }
+    else if (request.path == "/order" && request.method == "PUT") {
+        return handle_amend_order(request.body);
+    }
+    else if (request.path == "/log_level" && request.method == "PUT") {
+        return handle_set_log_level(request.body);
+    }
+    else if ((request.path == "/trades" || request.path.rfind("/trades?", 0) == 0) && request.method == "GET") {
+        return handle_get_trades(std::string(request.path));
+    }
     
     return HttpResponse(404, "{\"error\":\"Not Found\"}");
 }
 
-HttpResponse HttpServer::handle_place_order(const std::string& body) {
+HttpResponse HttpServer::handle_place_order(std::string_view body) {
     try {
         if (body.empty()) {
             return HttpResponse(400, "{\"error\":\"No JSON body found\"}");
         }
         
-        auto j = json::parse(body);
-
-        // Strict validation
-        if (!j.contains("price") || !j.contains("quantity") || !j.contains("side")) {
-            json err;
-            err["error"] = "Missing required fields";
-            err["required"] = {"price", "quantity", "side"};
-            err["received"] = j;
-            return HttpResponse(400, err.dump());
+        OrderRequest req;
+        double price_received = 0;
+        SymbolField symbol_field;
+        SymbolId symbol;
+        if (decode_order_request(body, req, price_received, symbol_field)) {
+            std::string error = resolve_symbol(engine_.symbols(), symbol_field, symbol);
+            if (!error.empty()) {
+                return HttpResponse(400, error);
+            }
+        } else {
+            // Whatever the fast decoder turns down, every invalid order
+            // included, goes through the DOM so errors read exactly as before
+            auto j = json::parse(body);
+            std::string error = parse_order_fields(j, req);
+            if (error.empty()) {
+                error = parse_symbol_field(engine_.symbols(), j, symbol);
+            }
+            if (!error.empty()) {
+                return HttpResponse(400, error);
+            }
+            if (req.type != OrderType::MARKET) {
+                price_received = j["price"].get<double>();
+            }
         }
+        bool is_market = req.type == OrderType::MARKET;
 
         // ============================================================
-        // CLEAR PRICE LOGIC: Always expect dollars (e.g., 100.50)
-        // Internally convert to cents (10050)
+        // ADD ORDER TO BOOK
         // ============================================================
-        Price price;
-        
-        if (j["price"].is_number()) {
-            double price_dollars = j["price"].get<double>();
-            
-            // Validate range
-            if (price_dollars <= 0.0) {
-                return HttpResponse(400, "{\"error\":\"Price must be positive\"}");
-            }
-            if (price_dollars > 1000000.0) {
-                return HttpResponse(400, "{\"error\":\"Price too large (max: $1,000,000)\"}");
-            }
-            
-            // Convert to cents (round to nearest cent)
-            price = static_cast<Price>(std::round(price_dollars * 100.0));
-            
-        } else {
-            return HttpResponse(400, "{\"error\":\"Price must be a number\"}");
+        // The matching thread hands back this order's trades with the result
+        std::string trades_json;
+        JsonWriter trades(trades_json);
+        trades.begin_array();
+        OrderResult result = is_market
+            ? engine_.add_market_order(symbol, req.quantity, req.side, req.protection_ticks)
+            : engine_.add_order(symbol, req.price, req.quantity, req.side, req.tif);
+        for (const Trade& trade : engine_.trades()) {
+            write_trade(trades, trade);
         }
-        
+        trades.end_array();
+
         // ============================================================
-        // QUANTITY VALIDATION
+        // BUILD RESPONSE WITH HUMAN-READABLE PRICES
         // ============================================================
-        if (!j["quantity"].is_number_unsigned()) {
-            return HttpResponse(400, "{\"error\":\"Quantity must be a positive integer\"}");
+        // Written directly, keys in the order json::dump() sorted them
+        std::string body_json;
+        body_json.reserve(256 + trades_json.size());
+        JsonWriter res(body_json);
+        res.begin_object()
+            .field("filled_quantity", result.filled_quantity)
+            .field("order_count", engine_.order_count())
+            .field("order_id", result.order_id)
+            .field("order_status", status_to_string(result.status));
+        if (!is_market) {
+            res.field("price_internal", req.price)       // Show internal representation
+               .field("price_received", price_received);  // Echo back what user sent
+        } else if (req.protection_ticks != OrderBook::kUnprotected) {
+            res.field("protection_ticks", req.protection_ticks);
         }
+        res.field("resting_quantity", result.resting_quantity)
+            .field("status", "success")
+            .field("time_in_force", tif_to_string(req.tif))
+            .key("trades").raw(trades_json)
+            .field("type", order_type_to_string(req.type))
+            .end_object();
         
-        Quantity quantity = j["quantity"].get<Quantity>();
+        return HttpResponse(200, std::move(body_json));
+    } 
+    catch (const EngineHalted&) {
+        return HttpResponse(503, kEngineHalted);
+    }
+    catch (const json::parse_error& e) {
+        json err;
+        err["error"] = "JSON parse error";
+        err["details"] = e.what();
+        err["body"] = body;
+        return HttpResponse(400, err.dump());
+    }
+    catch (const std::exception& e) {
+        json err;
+        err["error"] = "Exception";
+        err["msg"] = e.what();
+        return HttpResponse(400, err.dump());
+    }
+}
+
+HttpResponse HttpServer::handle_place_orders(std::string_view body) {
+    try {
+        if (body.empty()) {
+            return HttpResponse(400, "{\"error\":\"No JSON body found\"}");
+        }
         
-        if (quantity == 0) {
-            return HttpResponse(400, "{\"error\":\"Quantity must be greater than 0\"}");
+        auto j = json::parse(body);
+        if (!j.is_array()) {
+            return HttpResponse(400, "{\"error\":\"Body must be a JSON array of orders\"}");
         }
-        if (quantity > 1000000) {
-            return HttpResponse(400, "{\"error\":\"Quantity too large (max: 1,000,000)\"}");
+        if (j.empty()) {
+            return HttpResponse(400, "{\"error\":\"Batch is empty\"}");
         }
-        
+        if (j.size() > kMaxBatchOrders) {
+            return HttpResponse(400, "{\"error\":\"Batch too large (max: 1,000 orders)\"}");
+        }
+
         // ============================================================
-        // SIDE VALIDATION
+        // VALIDATE EVERY ENTRY; invalid ones are reported, not entered
         // ============================================================
-        if (!j["side"].is_string()) {
-            return HttpResponse(400, "{\"error\":\"Side must be a string\"}");
-        }
-        
-        std::string side_str = j["side"].get<std::string>();
-        
-        // Convert to uppercase for case-insensitive matching
-        std::transform(side_str.begin(), side_str.end(), side_str.begin(), ::toupper);
-        
-        Side side;
-        if (side_str == "BUY") {
-            side = Side::BUY;
-        } else if (side_str == "SELL") {
-            side = Side::SELL;
-        } else {
-            return HttpResponse(400, "{\"error\":\"Side must be 'BUY' or 'SELL'\"}");
-        }
+        // Valid entries are grouped by symbol, in order; each group is then
+        // one pass through its own book. Books are independent, so this
+        // matches exactly as entering them in body order would.
+        struct SymbolBatch {
+            SymbolId symbol;
+            std::vector<OrderRequest> requests;
+            std::vector<OrderResult> outcomes;
+            std::vector<Trade> trades;
+            size_t next_request = 0;
+            size_t next_trade = 0;
+            size_t order_count = 0;   // Resting in the symbol's book afterwards
+            bool halted = false;
+        };
+        std::vector<SymbolBatch> batches;
+        std::vector<std::string> errors(j.size());
+        std::vector<uint32_t> batch_of(j.size());
+        size_t accepted = 0;
+        for (size_t i = 0; i < j.size(); ++i) {
+            OrderRequest req;
+            SymbolId symbol;
+            errors[i] = parse_order_fields(j[i], req);
+            if (errors[i].empty()) {
+                errors[i] = parse_symbol_field(engine_.symbols(), j[i], symbol);
+            }
+            if (!errors[i].empty()) {
+                continue;
+            }
 
+            size_t b = 0;
+            while (b < batches.size() && batches[b].symbol != symbol) ++b;
+            if (b == batches.size()) {
+                batches.push_back(SymbolBatch{symbol, {}, {}, {}});
+            }
+            batches[b].requests.push_back(req);
+            batch_of[i] = static_cast<uint32_t>(b);
+            ++accepted;
+        }
         // ============================================================
-        // ADD ORDER TO BOOK
+        // MATCH EACH SYMBOL'S ENTRIES IN ONE PASS
         // ============================================================
-        auto trades = order_book_.add_order(price, quantity, side);
+        // A group whose shard has halted is refused on its own; the others
+        // are already entered
+        size_t trade_count = 0;
+        bool halted = false;
+        for (SymbolBatch& batch : batches) {
+            try {
+                engine_.add_orders(batch.symbol, batch.requests, batch.outcomes);
+            } catch (const EngineHalted&) {
+                batch.halted = true;
+                halted = true;
+                batch.order_count = engine_.market_data(batch.symbol).order_count;
+                continue;
+            }
+            batch.order_count = engine_.order_count();
+            batch.trades = engine_.trades();
+            trade_count += batch.trades.size();
+        }
+        if (halted) {
+            for (size_t i = 0; i < j.size(); ++i) {
+                if (errors[i].empty() && batches[batch_of[i]].halted) {
+                    errors[i] = kEngineHalted;
+                    --accepted;
+                }
+            }
+        }
 
         // ============================================================
-        // BUILD RESPONSE WITH HUMAN-READABLE PRICES
+        // BUILD PER-ORDER RESPONSE
         // ============================================================
-        json res;
-        res["status"] = "success";
-        res["order_count"] = order_book_.get_order_count();
-        res["price_received"] = j["price"].get<double>();  // Echo back what user sent
-        res["price_internal"] = price;  // Show internal representation
-        
-        // Add trades
-        json trades_array = json::array();
-        for (const auto& trade : trades) {
-            json trade_obj;
-            trade_obj["buyer_id"] = trade.buyer_id;
-            trade_obj["seller_id"] = trade.seller_id;
-            trade_obj["price"] = trade.price / 100.0;  // Convert back to dollars for display
-            trade_obj["price_cents"] = trade.price;     // Also show cents for debugging
-            trade_obj["quantity"] = trade.quantity;
-            trades_array.push_back(trade_obj);
+        // Trades arrive in execution order, so each order's fills are the
+        // run of its book's trades naming it as the taker. Ids are assigned
+        // in arrival order and a taker only meets older resting orders, so
+        // the taker is always the higher id of the two.
+        //
+        // A batch for one book reports that book's order_count, as a single
+        // order does; one spanning several reports each in order_counts. With
+        // nothing valid, the count is the default symbol's, as last published.
+        std::string body_json;
+        body_json.reserve(64 + 192 * j.size() + 96 * trade_count + 48 * batches.size());
+        JsonWriter res(body_json);
+        res.begin_object()
+            .field("accepted", accepted)
+            .field("invalid", j.size() - accepted);
+        if (batches.empty()) {
+            res.field("order_count", engine_.market_data(0).order_count);
+        } else if (batches.size() == 1) {
+            res.field("order_count", batches[0].order_count);
+        } else {
+            res.key("order_counts").begin_array();
+            for (const SymbolBatch& batch : batches) {
+                res.begin_object()
+                   .field("order_count", batch.order_count)
+                   .field("symbol", engine_.symbols().name(batch.symbol))
+                   .end_object();
+            }
+            res.end_array();
         }
-        res["trades"] = trades_array;
+        res.key("results").begin_array();
+
+        for (size_t i = 0; i < j.size(); ++i) {
+            res.begin_object();
+            if (!errors[i].empty()) {
+                // The error is already a serialized object
+                res.key("error").raw(errors[i])
+                   .field("index", i)
+                   .end_object();
+                continue;
+            }
+
+            SymbolBatch& batch = batches[batch_of[i]];
+            const OrderRequest& req = batch.requests[batch.next_request];
+            const OrderResult& result = batch.outcomes[batch.next_request++];
+            const std::vector<Trade>& trades = batch.trades;
+            res.field("filled_quantity", result.filled_quantity)
+               .field("index", i)
+               .field("order_id", result.order_id)
+               .field("order_status", status_to_string(result.status))
+               .field("resting_quantity", result.resting_quantity)
+               .field("time_in_force", tif_to_string(req.tif))
+               .key("trades").begin_array();
+            while (result.order_id != 0 && batch.next_trade < trades.size() &&
+                   std::max(trades[batch.next_trade].buyer_id, trades[batch.next_trade].seller_id) == result.order_id) {
+                write_trade(res, trades[batch.next_trade++]);
+            }
+            res.end_array()
+               .field("type", order_type_to_string(req.type))
+               .end_object();
+        }
+        res.end_array()
+            .field("status", "success")
+            .end_object();
         
-        return HttpResponse(200, res.dump());
+        return HttpResponse(200, std::move(body_json));
     } 
     catch (const json::parse_error& e) {
         json err;
@@ -271,103 +1012,340 @@ HttpResponse HttpServer::handle_place_order(const std::string& body) {
     }
 }
 
-HttpResponse HttpServer::handle_cancel_order(const std::string& body) {
+HttpResponse HttpServer::handle_cancel_order(std::string_view body) {
+    try {
+        OrderId order_id;
+        if (!decode_cancel_request(body, order_id)) {
+            auto j = json::parse(body);
+            
+            if (!j.contains("order_id")) {
+                return HttpResponse(400, "{\"error\":\"Missing order_id\"}");
+            }
+            
+            order_id = j["order_id"].get<OrderId>();
+        }
+        bool success = engine_.cancel_order(order_id);
+        
+        std::string body_json;
+        JsonWriter res(body_json);
+        if (success) {
+            res.begin_object()
+                .field("order_id", order_id)
+                .field("status", "cancelled")
+                .end_object();
+            return HttpResponse(200, std::move(body_json));
+        } else {
+            res.begin_object()
+                .field("error", "Order not found")
+                .field("order_id", order_id)
+                .end_object();
+            return HttpResponse(404, std::move(body_json));
+        }
+    }
+    catch (const EngineHalted&) {
+        return HttpResponse(503, kEngineHalted);
+    }
+    catch (const std::exception& e) {
+        return HttpResponse(400, "{\"error\":\"Invalid request\"}");
+    }
+}
+
+HttpResponse HttpServer::handle_amend_order(std::string_view body) {
     try {
         auto j = json::parse(body);
         
-        if (!j.contains("order_id")) {
-            return HttpResponse(400, "{\"error\":\"Missing order_id\"}");
+        if (!j.contains("order_id") || !j.contains("price") || !j.contains("quantity")) {
+            json err;
+            err["error"] = "Missing required fields";
+            err["required"] = {"order_id", "price", "quantity"};
+            err["received"] = j;
+            return HttpResponse(400, err.dump());
         }
         
         OrderId order_id = j["order_id"].get<OrderId>();
-        bool success = order_book_.cancel_order(order_id);
+        
+        Price price;
+        std::string error = parse_price_field(j["price"], price);
+        if (!error.empty()) {
+            return HttpResponse(400, error);
+        }
+        
+        Quantity quantity;
+        error = parse_quantity_field(j["quantity"], quantity);
+        if (!error.empty()) {
+            return HttpResponse(400, error);
+        }
+        
+        bool success = engine_.amend_order(order_id, price, quantity);
+        json trades_array = json::array();
+        for (const Trade& trade : engine_.trades()) {
+            trades_array.push_back(trade_to_json(trade));
+        }
         
         json res;
-        if (success) {
-            res["status"] = "cancelled";
-            res["order_id"] = order_id;
-            return HttpResponse(200, res.dump());
-        } else {
+        res["order_id"] = order_id;
+        if (!success) {
             res["error"] = "Order not found";
-            res["order_id"] = order_id;
             return HttpResponse(404, res.dump());
         }
+        res["status"] = "amended";
+        res["order_count"] = engine_.order_count();
+        res["trades"] = trades_array;
+        return HttpResponse(200, res.dump());
     }
-    catch (const std::exception& e) {
+    catch (const EngineHalted&) {
+        return HttpResponse(503, kEngineHalted);
+    }
+    catch (const json::exception& e) {
         return HttpResponse(400, "{\"error\":\"Invalid request\"}");
     }
+    catch (const std::exception& e) {
+        json err;
+        err["error"] = "Exception";
+        err["msg"] = e.what();
+        return HttpResponse(400, err.dump());
+    }
 }
 
-HttpResponse HttpServer::handle_get_orderbook() {
-    json res;
+HttpResponse HttpServer::handle_get_orderbook(std::string_view target) {
+    SymbolId symbol = query_symbol(engine_.symbols(), target);
+    if (symbol == SymbolDirectory::kNoSymbol) {
+        return HttpResponse(404, kUnknownSymbol);
+    }
+    // Published by the engine's market-data stage, formatted here
+    MarketData book = engine_.market_data(symbol);
     
     // Return prices in dollars for user-friendliness
-    Price best_bid = order_book_.get_best_bid();
-    Price best_ask = order_book_.get_best_ask();
-    Price spread = order_book_.get_spread();
-    
-    res["best_bid"] = best_bid > 0 ? best_bid / 100.0 : 0.0;
-    res["best_ask"] = best_ask > 0 ? best_ask / 100.0 : 0.0;
-    res["spread"] = spread > 0 ? spread / 100.0 : 0.0;
-    
-    // Also include internal representation for debugging
-    res["best_bid_cents"] = best_bid;
-    res["best_ask_cents"] = best_ask;
-    
-    res["order_count"] = order_book_.get_order_count();
-    res["bid_levels"] = order_book_.get_bid_level_count();
-    res["ask_levels"] = order_book_.get_ask_level_count();
+    std::string body_json;
+    JsonWriter res(body_json);
+    res.begin_object()
+        .field("ask_levels", book.ask_levels)
+        .key("best_ask").price(book.best_ask)
+        .field("best_ask_cents", book.best_ask)  // Internal representation for debugging
+        .key("best_bid").price(book.best_bid)
+        .field("best_bid_cents", book.best_bid)
+        .field("bid_levels", book.bid_levels)
+        .field("order_count", book.order_count)
+        .key("spread").price(book.spread)
+        .end_object();
     
-    return HttpResponse(200, res.dump());
+    return HttpResponse(200, std::move(body_json));
 }
 
-HttpResponse HttpServer::handle_get_stats() {
-    json res;
-    res["total_orders"] = order_book_.get_order_count();
-    res["bid_levels"] = order_book_.get_bid_level_count();
-    res["ask_levels"] = order_book_.get_ask_level_count();
-    
-    Price best_bid = order_book_.get_best_bid();
-    Price best_ask = order_book_.get_best_ask();
-    Price spread = order_book_.get_spread();
-    
-    res["best_bid"] = best_bid > 0 ? best_bid / 100.0 : 0.0;
-    res["best_ask"] = best_ask > 0 ? best_ask / 100.0 : 0.0;
-    res["spread"] = spread > 0 ? spread / 100.0 : 0.0;
+HttpResponse HttpServer::handle_get_stats(std::string_view target) {
+    SymbolId symbol = query_symbol(engine_.symbols(), target);
+    if (symbol == SymbolDirectory::kNoSymbol) {
+        return HttpResponse(404, kUnknownSymbol);
+    }
+    MarketData book = engine_.market_data(symbol);
+    const OrderPoolStats& pool = book.pool;
     
-    if (best_bid > 0 && best_ask > 0) {
-        res["mid_price"] = (best_bid + best_ask) / 200.0;  // Divide by 200 because already in cents
+    std::string body_json;
+    JsonWriter res(body_json);
+    res.begin_object()
+        .field("ask_levels", book.ask_levels)
+        .key("best_ask").price(book.best_ask)
+        .key("best_bid").price(book.best_bid)
+        .field("bid_levels", book.bid_levels)
+        .key("last_price");
+    if (book.traded_volume > 0) {
+        res.price(book.last_trade_price);
     } else {
-        res["mid_price"] = nullptr;
+        res.null();
     }
+    res.key("mid_price");
+    if (book.best_bid > 0 && book.best_ask > 0) {
+        res.value((book.best_bid + book.best_ask) / 200.0);  // Divide by 200 because already in cents
+    } else {
+        res.null();
+    }
+    res.key("order_pool").begin_object()
+            .field("capacity", pool.capacity)
+            .field("high_water_mark", pool.high_water_mark)
+            .field("in_use", pool.in_use)
+            .field("slabs", pool.slab_count)
+            .end_object()
+        .key("spread").price(book.spread)
+        .field("total_orders", book.order_count)
+        .field("volume", book.traded_volume)
+        .end_object();
     
-    return HttpResponse(200, res.dump());
+    return HttpResponse(200, std::move(body_json));
 }
 
-HttpResponse HttpServer::handle_health_check() {
-    return HttpResponse(200, "{\"status\":\"ok\"}");
+HttpResponse HttpServer::handle_get_engine_stats() {
+    // Every shard totals its own books at once, into its own slot
+    struct alignas(64) ShardTotals {
+        size_t symbols = 0;
+        size_t orders = 0;
+        size_t bid_levels = 0;
+        size_t ask_levels = 0;
+        uint64_t trades = 0;
+        OrderPoolStats pool{};
+    };
+    std::vector<ShardTotals> shards(engine_.shard_count());
+    engine_.query_all([&shards](size_t shard, SymbolId, const OrderBook& book) {
+        ShardTotals& totals = shards[shard];
+        OrderPoolStats pool = book.get_pool_stats();
+        ++totals.symbols;
+        totals.orders += book.get_order_count();
+        totals.bid_levels += book.get_bid_level_count();
+        totals.ask_levels += book.get_ask_level_count();
+        totals.trades += book.get_trade_journal().last_sequence();
+        totals.pool.capacity += pool.capacity;
+        totals.pool.in_use += pool.in_use;
+        totals.pool.slab_count += pool.slab_count;
+    });
+
+    ShardTotals engine;
+    for (const ShardTotals& totals : shards) {
+        engine.symbols += totals.symbols;
+        engine.orders += totals.orders;
+        engine.bid_levels += totals.bid_levels;
+        engine.ask_levels += totals.ask_levels;
+        engine.trades += totals.trades;
+        engine.pool.capacity += totals.pool.capacity;
+        engine.pool.in_use += totals.pool.in_use;
+        engine.pool.slab_count += totals.pool.slab_count;
+    }
+
+    auto write_totals = [](JsonWriter& res, const ShardTotals& totals) {
+        res.field("ask_levels", totals.ask_levels)
+            .field("bid_levels", totals.bid_levels)
+            .key("order_pool").begin_object()
+                .field("capacity", totals.pool.capacity)
+                .field("in_use", totals.pool.in_use)
+                .field("slabs", totals.pool.slab_count)
+                .end_object();
+    };
+
+    std::string body_json;
+    JsonWriter res(body_json);
+    res.begin_object();
+    write_totals(res, engine);
+    res.key("shards").begin_array();
+    for (size_t shard = 0; shard < shards.size(); ++shard) {
+        res.begin_object();
+        write_totals(res, shards[shard]);
+        res.field("shard", shard)
+            .field("symbols", shards[shard].symbols)
+            .field("total_orders", shards[shard].orders)
+            .field("trades", shards[shard].trades)
+            .end_object();
+    }
+    res.end_array()
+        .field("symbols", engine.symbols)
+        .field("total_orders", engine.orders)
+        .field("trades", engine.trades)
+        .end_object();
+
+    return HttpResponse(200, std::move(body_json));
 }
 
-std::string HttpServer::build_response(const HttpResponse& response) {
-    std::ostringstream oss;
-    
-    std::string status_text;
-    switch(response.status_code) {
-        case 200: status_text = "OK"; break;
-        case 400: status_text = "Bad Request"; break;
-        case 404: status_text = "Not Found"; break;
-        case 500: status_text = "Internal Server Error"; break;
-        case 501: status_text = "Not Implemented"; break;
-        default: status_text = "Unknown"; break;
+HttpResponse HttpServer::handle_set_log_level(std::string_view body) {
+    try {
+        auto j = json::parse(body);
+        LogLevel level;
+        if (!j.contains("level") || !j["level"].is_string() ||
+            !parse_log_level(j["level"].get<std::string>(), level)) {
+            return HttpResponse(400, "{\"error\":\"level must be 'DEBUG', 'INFO', 'WARN', 'ERROR' or 'OFF'\"}");
+        }
+        
+        Logger::set_level(level);
+        json res;
+        res["status"] = "success";
+        res["level"] = log_level_to_string(level);
+        return HttpResponse(200, res.dump());
     }
-    
-    oss << "HTTP/1.1 " << response.status_code << " " << status_text << "\r\n"
-        << "Content-Type: application/json\r\n"
-        << "Content-Length: " << response.body.length() << "\r\n"
-        << "Access-Control-Allow-Origin: *\r\n"
-        << "Connection: close\r\n\r\n"
-        << response.body;
-    return oss.str();
+    catch (const std::exception& e) {
+        json err;
+        err["error"] = "Exception";
+        err["msg"] = e.what();
+        return HttpResponse(400, err.dump());
+    }
+}
+
+HttpResponse HttpServer::handle_get_trades(const std::string& target) {
+    // GET /trades?since=S returns trades with sequence >= S,
+    // GET /trades?last=N the N most recent; both capped at kMaxTradesPerQuery.
+    // Sequences are per symbol (?symbol=, default symbol otherwise).
+    const size_t kMaxTradesPerQuery = 1000;
+
+    SymbolId symbol = query_symbol(engine_.symbols(), target);
+    if (symbol == SymbolDirectory::kNoSymbol) {
+        return HttpResponse(404, kUnknownSymbol);
+    }
+
+    auto query_value = [&target](const std::string& key) -> const char* {
+        size_t pos = target.find('?');
+        while (pos != std::string::npos) {
+            if (target.compare(pos + 1, key.size() + 1, key + "=") == 0) {
+                return target.c_str() + pos + key.size() + 2;
+            }
+            pos = target.find('&', pos + 1);
+        }
+        return nullptr;
+    };
+
+    const char* since = query_value("since");
+    const char* last = query_value("last");
+    std::vector<TradeRecord> records;
+    TradeSeq first_available = 0;
+    TradeSeq last_sequence = 0;
+    engine_.query(symbol, [&](const OrderBook& book) {
+        const TradeJournal& journal = book.get_trade_journal();
+        if (since) {
+            records = journal.since(std::strtoull(since, nullptr, 10), kMaxTradesPerQuery);
+        } else {
+            size_t n = last ? std::strtoull(last, nullptr, 10) : 100;
+            records = journal.last(std::min(n, kMaxTradesPerQuery));
+        }
+        first_available = journal.first_available();
+        last_sequence = journal.last_sequence();
+    });
+
+    json trades_array = json::array();
+    for (const auto& record : records) {
+        trades_array.push_back({
+            {"sequence", record.sequence},
+            {"buyer_id", SymbolDirectory::to_global(symbol, record.trade.buyer_id)},
+            {"seller_id", SymbolDirectory::to_global(symbol, record.trade.seller_id)},
+            {"price", record.trade.price / 100.0},
+            {"price_cents", record.trade.price},
+            {"quantity", record.trade.quantity}
+        });
+    }
+
+    json res;
+    res["first_available"] = first_available;
+    res["last_sequence"] = last_sequence;
+    res["trades"] = trades_array;
+    return HttpResponse(200, res.dump());
+}
+
+HttpResponse HttpServer::handle_get_symbols() {
+    const SymbolDirectory& symbols = engine_.symbols();
+
+    std::string body_json;
+    body_json.reserve(32 + 52 * symbols.size());
+    JsonWriter res(body_json);
+    res.begin_object()
+        .key("symbols").begin_array();
+    for (SymbolId symbol = 0; symbol < symbols.size(); ++symbol) {
+        res.begin_object()
+            .field("id", symbol)
+            .field("name", symbols.name(symbol))
+            .field("shard", engine_.shard_of(symbol))
+            .end_object();
+    }
+    res.end_array()
+        .end_object();
+
+    return HttpResponse(200, std::move(body_json));
+}
+
+HttpResponse HttpServer::handle_health_check() {
+    return HttpResponse(200, "{\"status\":\"ok\"}");
 }
 
 } // namespace trading
\ No newline at end of file
@@ -0,0 +1,71 @@
+#include "../include/input_journal.hpp"
+#include <cerrno>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace trading {
+
+InputJournal::InputJournal()
+    : fd_(-1)
+    , written_(0)
+{}
+
+InputJournal::~InputJournal() {
+    flush();
+    close();
+}
+
+bool InputJournal::open(const std::string& path) {
+#ifdef _WIN32
+    (void)path;
+    return false;
+#else
+    close();
+    int fd = ::open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+    if (fd < 0) return false;
+
+    fd_ = fd;
+    path_ = path;
+    written_ = 0;
+    return true;
+#endif
+}
+
+bool InputJournal::flush() {
+    if (pending_.empty()) return true;
+#ifdef _WIN32
+    pending_.clear();
+    return false;
+#else
+    const char* data = reinterpret_cast<const char*>(pending_.data());
+    size_t remaining = pending_.size() * sizeof(InputRecord);
+    while (remaining > 0) {
+        ssize_t n = ::write(fd_, data, remaining);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            pending_.clear();
+            close();
+            return false;
+        }
+        data += n;
+        remaining -= static_cast<size_t>(n);
+    }
+    written_ += pending_.size();
+    pending_.clear();
+    return true;
+#endif
+}
+
+void InputJournal::close() {
+#ifndef _WIN32
+    if (fd_ >= 0) {
+        ::close(fd_);
+        fd_ = -1;
+    }
+#endif
+}
+
+}
@@ -0,0 +1,231 @@
+#include "../include/logger.hpp"
+#include <chrono>
+#include <ctime>
+#include <charconv>
+#include <cctype>
+
+namespace trading {
+
+const char* log_level_to_string(LogLevel level) {
+    switch (level) {
+        case LogLevel::DEBUG: return "DEBUG";
+        case LogLevel::INFO: return "INFO";
+        case LogLevel::WARN: return "WARN";
+        case LogLevel::ERROR: return "ERROR";
+        case LogLevel::OFF: return "OFF";
+        default: return "UNKNOWN";
+    }
+}
+
+bool parse_log_level(std::string_view name, LogLevel& level) {
+    for (LogLevel candidate : {LogLevel::DEBUG, LogLevel::INFO, LogLevel::WARN, LogLevel::ERROR, LogLevel::OFF}) {
+        std::string_view expected = log_level_to_string(candidate);
+        if (name.size() != expected.size()) continue;
+
+        bool match = true;
+        for (size_t i = 0; i < name.size() && match; ++i) {
+            match = std::toupper(static_cast<unsigned char>(name[i])) == expected[i];
+        }
+        if (match) {
+            level = candidate;
+            return true;
+        }
+    }
+    return false;
+}
+
+// --- LogRing ---
+
+LogRing::LogRing(size_t capacity)
+    : buffer_(capacity)
+    , mask_(capacity - 1)
+{}
+
+unsigned char* LogRing::reserve(size_t size) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t offset = tail & mask_;
+    size_t contiguous = buffer_.size() - offset;
+
+    // Records never wrap: pad out the end of the buffer and start over
+    size_t needed = size <= contiguous ? size : contiguous + size;
+    if (tail + needed - cached_head_ > buffer_.size()) {
+        // Only touch the consumer's cache line when the ring looks full
+        cached_head_ = head_.load(std::memory_order_acquire);
+        if (tail + needed - cached_head_ > buffer_.size()) return nullptr;
+    }
+    if (size > contiguous) {
+        uint32_t padding = kPadding;
+        std::memcpy(&buffer_[offset], &padding, sizeof(padding));
+        tail += contiguous;
+    }
+    pending_ = tail;
+    return &buffer_[tail & mask_];
+}
+
+void LogRing::commit(size_t size) {
+    tail_.store(pending_ + size, std::memory_order_release);
+}
+
+// --- Logger ---
+
+Logger& Logger::instance() {
+    static Logger logger;
+    return logger;
+}
+
+Logger::~Logger() {
+    stop();
+}
+
+void Logger::start(FILE* out, LogLevel level) {
+    if (running_.exchange(true)) return;
+    out_ = out;
+    writer_ = std::thread([this] { run(); });
+    set_level(level);
+}
+
+void Logger::stop() {
+    if (!running_.exchange(false)) return;
+    set_level(LogLevel::OFF);
+    writer_.join();
+    drain_all();
+    std::fflush(out_);
+}
+
+LogRing& Logger::thread_ring() {
+    // The thread's ring is registered once; the holder marks it retired when
+    // the thread exits so the writer can drop it after the final drain
+    struct Holder {
+        std::shared_ptr<LogRing> ring;
+        ~Holder() {
+            if (ring) ring->retired.store(true, std::memory_order_release);
+        }
+    };
+    thread_local Holder holder;
+
+    if (!holder.ring) {
+        holder.ring = std::make_shared<LogRing>(kRingBytes);
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings_.push_back(holder.ring);
+    }
+    return *holder.ring;
+}
+
+size_t Logger::ring_count() {
+    std::lock_guard<std::mutex> lock(rings_mutex_);
+    return rings_.size();
+}
+
+int64_t Logger::now_ns() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+}
+
+void Logger::run() {
+    while (running_.load(std::memory_order_acquire)) {
+        if (drain_all() == 0) {
+            std::fflush(out_);
+            std::this_thread::sleep_for(std::chrono::microseconds(500));
+        }
+    }
+}
+
+size_t Logger::drain_all() {
+    std::vector<std::shared_ptr<LogRing>> rings;
+    {
+        std::lock_guard<std::mutex> lock(rings_mutex_);
+        rings = rings_;
+    }
+
+    size_t count = 0;
+    for (const auto& ring : rings) {
+        // Read retired first: a ring retired before this drain is empty after it
+        bool retired = ring->retired.load(std::memory_order_acquire);
+        count += ring->drain([this](const unsigned char* record, size_t size) {
+            format_record(record, size);
+        });
+
+        uint64_t dropped = ring->dropped.exchange(0, std::memory_order_relaxed);
+        if (dropped > 0) {
+            std::fprintf(out_, "WARN  logger: dropped %llu records, ring full\n",
+                         static_cast<unsigned long long>(dropped));
+        }
+        if (retired) {
+            std::lock_guard<std::mutex> lock(rings_mutex_);
+            for (size_t i = 0; i < rings_.size(); ++i) {
+                if (rings_[i] == ring) {
+                    rings_.erase(rings_.begin() + i);
+                    break;
+                }
+            }
+        }
+    }
+    return count;
+}
+
+void Logger::format_record(const unsigned char* record, size_t size) {
+    RecordHeader header;
+    std::memcpy(&header, record, sizeof(header));
+    const unsigned char* arg = record + sizeof(header);
+    const unsigned char* end = record + size;
+
+    // "HH:MM:SS.uuuuuu LEVEL message"
+    std::time_t seconds = static_cast<std::time_t>(header.timestamp_ns / 1000000000);
+    std::tm tm{};
+#ifdef _WIN32
+    localtime_s(&tm, &seconds);
+#else
+    localtime_r(&seconds, &tm);
+#endif
+    char prefix[40];
+    int n = std::snprintf(prefix, sizeof(prefix), "%02d:%02d:%02d.%06lld %-5s ", tm.tm_hour, tm.tm_min, tm.tm_sec,
+                          static_cast<long long>(header.timestamp_ns % 1000000000 / 1000), log_level_to_string(header.level));
+    line_.assign(prefix, static_cast<size_t>(n));
+
+    char number[32];
+    for (const char* f = header.format; *f != '\0'; ++f) {
+        if (f[0] != '{' || f[1] != '}' || arg >= end || *arg == 0) {
+            line_.push_back(*f);
+            continue;
+        }
+        ++f;
+
+        unsigned char tag = *arg++;
+        if (tag == kString) {
+            uint32_t length;
+            std::memcpy(&length, arg, sizeof(length));
+            line_.append(reinterpret_cast<const char*>(arg + 4), length);
+            arg += 4 + length;
+            continue;
+        }
+
+        uint64_t bits;
+        std::memcpy(&bits, arg, 8);
+        arg += 8;
+        if (tag == kDouble) {
+            double value;
+            std::memcpy(&value, &bits, 8);
+            line_.append(number, static_cast<size_t>(std::snprintf(number, sizeof(number), "%g", value)));
+        } else if (tag == kBool) {
+            line_.append(bits ? "true" : "false");
+        } else if (tag == kInt) {
+            char* last = std::to_chars(number, number + sizeof(number), static_cast<int64_t>(bits)).ptr;
+            line_.append(number, static_cast<size_t>(last - number));
+        } else {
+            char* last = std::to_chars(number, number + sizeof(number), bits).ptr;
+            line_.append(number, static_cast<size_t>(last - number));
+        }
+    }
+    line_.push_back('\n');
+    std::fwrite(line_.data(), 1, line_.size(), out_);
+}
+
+unsigned char* Logger::encode_string(unsigned char* out, std::string_view value) {
+    uint32_t length = static_cast<uint32_t>(clamp(value.size()));
+    *out++ = kString;
+    std::memcpy(out, &length, sizeof(length));
+    std::memcpy(out + 4, value.data(), length);
+    return out + 4 + length;
+}
+
+}
@@ -1,19 +1,31 @@
 #include <iostream>
 #include <thread>
 #include <csignal>
-#include "../include/order_book.hpp"
+#include <cstdlib>
+#include <algorithm>
+#include <vector>
+#include <memory>
+#include <string>
+#include "../include/symbol_directory.hpp"
+#include "../include/matching_engine.hpp"
 #include "../include/http_server.hpp"
+#include "../include/binary_server.hpp"
+#include "../include/logger.hpp"
 
 using namespace trading;
 
-// Global server pointer for signal handling
-HttpServer* g_server = nullptr;
+// Global server pointers for signal handling
+std::vector<std::unique_ptr<HttpServer>> g_servers;
+BinaryServer* g_binary_server = nullptr;
 
 // Signal handler
 void signal_handler(int signal) {
     std::cout << "\nReceived signal " << signal << ", shutting down..." << std::endl;
-    if (g_server) {
-        g_server->stop();
+    for (auto& server : g_servers) {
+        server->stop();
+    }
+    if (g_binary_server) {
+        g_binary_server->stop();
     }
 }
 
@@ -22,23 +34,140 @@ int main() {
     std::cout << "   🚀 TRADING ENGINE MATCHING ENGINE" << std::endl;
     std::cout << "========================================" << std::endl;
     std::cout << "Version: 1.0.0" << std::endl;
+    // Binary order entry listens beside HTTP; ENGINE_BINARY_PORT=0 turns it off
+    int binary_port = 9090;
+    if (const char* port = std::getenv("ENGINE_BINARY_PORT")) {
+        binary_port = std::atoi(port);
+    }
     std::cout << "Port: 8080" << std::endl;
+    if (binary_port > 0) {
+        std::cout << "Binary port: " << binary_port << std::endl;
+    }
     std::cout << "========================================\n" << std::endl;
     
-    // Create order book
-    OrderBook order_book;
+    // Request logging goes through the async logger; ENGINE_LOG_LEVEL picks
+    // the starting level, PUT /log_level changes it while running
+    LogLevel log_level = LogLevel::INFO;
+    if (const char* level = std::getenv("ENGINE_LOG_LEVEL")) {
+        if (!parse_log_level(level, log_level)) {
+            std::cerr << "Unknown ENGINE_LOG_LEVEL " << level << ", using INFO" << std::endl;
+        }
+    }
+    Logger::instance().start(stdout, log_level);
     
-    // Create HTTP server
-    HttpServer server(8080, order_book);
-    g_server = &server;
+    // One order book per instrument. ENGINE_SYMBOLS lists them, comma
+    // separated; the first is the default for requests that name none and
+    // gets its order storage up front, the rest on their first order.
+    SymbolDirectory symbols;
+    std::string symbol_list = "DEFAULT";
+    if (const char* list = std::getenv("ENGINE_SYMBOLS")) {
+        symbol_list = list;
+    }
+    size_t start = 0;
+    while (start <= symbol_list.size()) {
+        size_t end = std::min(symbol_list.find(',', start), symbol_list.size());
+        std::string name = symbol_list.substr(start, end - start);
+        start = end + 1;
+        if (name.empty()) continue;
+        size_t capacity = symbols.size() == 0 ? OrderPool::kOrdersPerSlab : 0;
+        if (symbols.add(name, capacity) == SymbolDirectory::kNoSymbol) {
+            std::cerr << "Ignoring symbol '" << name << "' (1 to " << SymbolDirectory::kMaxNameLength
+                      << " characters)" << std::endl;
+        }
+    }
+    if (symbols.size() == 0) {
+        symbols.add("DEFAULT", OrderPool::kOrdersPerSlab);
+    }
+    std::cout << "Symbols: " << symbols.size() << " (default " << symbols.name(0) << ")" << std::endl;
+    
+    // Optionally keep trade history beyond the in-memory ring: one spill file
+    // per symbol, ENGINE_TRADE_JOURNAL itself for a lone symbol and
+    // ENGINE_TRADE_JOURNAL.<symbol> once there are several
+    if (const char* journal_path = std::getenv("ENGINE_TRADE_JOURNAL")) {
+        size_t opened = 0;
+        for (SymbolId symbol = 0; symbol < symbols.size(); ++symbol) {
+            std::string path = journal_path;
+            if (symbols.size() > 1) path += "." + symbols.name(symbol);
+            if (symbols.book(symbol).get_trade_journal().open_spill_file(path)) {
+                ++opened;
+            } else {
+                std::cerr << "Could not open trade journal " << path << std::endl;
+            }
+        }
+        if (opened > 0) {
+            std::cout << "Trade journal spilling to " << journal_path
+                      << (symbols.size() > 1 ? ".<symbol>" : "") << std::endl;
+        }
+    }
+    
+    // ENGINE_SHARDS matching threads split the books between them;
+    // ENGINE_MATCHING_CPU pins the first, the rest to the CPUs after it, and
+    // ENGINE_INPUT_JOURNAL journals every input before it is acknowledged
+    MatchingEngineConfig engine_config;
+    if (const char* shards = std::getenv("ENGINE_SHARDS")) {
+        engine_config.shards = static_cast<size_t>(std::max(1, std::atoi(shards)));
+    }
+    if (const char* cpu = std::getenv("ENGINE_MATCHING_CPU")) {
+        engine_config.cpu = std::atoi(cpu);
+    }
+    if (const char* journal_path = std::getenv("ENGINE_INPUT_JOURNAL")) {
+        engine_config.journal_path = journal_path;
+    }
+    MatchingEngine engine(symbols, engine_config);
+    std::cout << "Matching shards: " << engine.shard_count() << std::endl;
+    if (engine.journaling()) {
+        std::cout << "Input journal writing to " << engine_config.journal_path
+                  << (engine.shard_count() > 1 ? ".<shard>" : "") << std::endl;
+    } else if (!engine_config.journal_path.empty()) {
+        std::cerr << "Could not open input journal " << engine_config.journal_path << std::endl;
+    }
+    
+    // Create HTTP servers: ENGINE_HTTP_THREADS event loops share port 8080,
+    // each a gateway into the matching shards
+    HttpServerConfig config;
+    if (const char* backlog = std::getenv("ENGINE_LISTEN_BACKLOG")) {
+        config.backlog = std::atoi(backlog);
+    }
+    int http_threads = 1;
+    if (const char* threads = std::getenv("ENGINE_HTTP_THREADS")) {
+        http_threads = std::max(1, std::atoi(threads));
+    }
+    config.reuse_port = http_threads > 1;
+    for (int i = 0; i < http_threads; ++i) {
+        g_servers.push_back(std::make_unique<HttpServer>(8080, engine.add_gateway(), config));
+    }
+    
+    BinaryServerConfig binary_config;
+    binary_config.backlog = config.backlog;
+    BinaryServer binary_server(binary_port, engine.add_gateway(), binary_config);
+    g_binary_server = &binary_server;
     
     // Setup signal handlers
     signal(SIGINT, signal_handler);  
     signal(SIGTERM, signal_handler); 
     
+    engine.start();
+    std::vector<std::thread> gateway_threads;
+    if (binary_port > 0) {
+        gateway_threads.emplace_back([&binary_server] { binary_server.start(); });
+    }
+    for (size_t i = 1; i < g_servers.size(); ++i) {
+        gateway_threads.emplace_back([i] { g_servers[i]->start(); });
+    }
+    
     // Start server (blocking)
-    server.start();
+    g_servers[0]->start();
+    
+    for (auto& server : g_servers) {
+        server->stop();
+    }
+    binary_server.stop();
+    for (auto& thread : gateway_threads) {
+        thread.join();
+    }
+    engine.stop();
     
+    Logger::instance().stop();
     std::cout << "\nShutdown complete." << std::endl;
     
     return 0;
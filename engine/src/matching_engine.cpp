@@ -0,0 +1,447 @@
+#include "../include/matching_engine.hpp"
+#include "../include/thread_affinity.hpp"
+#include "../include/logger.hpp"
+#include <algorithm>
+#include <cstring>
+
+namespace trading {
+
+namespace {
+
+void summarize_book(const OrderBook& book, MarketData& out) {
+    out.best_bid = book.get_best_bid();
+    out.best_ask = book.get_best_ask();
+    out.spread = book.get_spread();
+    out.order_count = book.get_order_count();
+    out.bid_levels = book.get_bid_level_count();
+    out.ask_levels = book.get_ask_level_count();
+    out.pool = book.get_pool_stats();
+}
+
+}
+
+// --- Gateway ---
+
+EngineEvent& MatchingEngine::Gateway::claim(EngineEvent::Type type, SymbolId symbol) {
+    shard_ = engine_.shards_[engine_.shard_of(symbol)].get();
+    if (type != EngineEvent::Type::QUERY && shard_->halted()) throw EngineHalted();
+    sequence_ = shard_->ring.claim();
+    EngineEvent& event = shard_->ring[sequence_];
+    event.type = type;
+    event.gateway = id_;
+    event.symbol = symbol;
+    return event;
+}
+
+const EngineResponse& MatchingEngine::Gateway::submit() {
+    shard_->ring.publish(sequence_);
+
+    // Batch buffers and error_ are shared with the stages until the matcher,
+    // the last stage to look at them, is past this event
+    IdleBackoff backoff(true);
+    while (shard_->matched.get() < sequence_) backoff.pause();
+
+    if (response_.halted) throw EngineHalted();
+    if (response_.failed) throw std::out_of_range(error_);
+    return response_;
+}
+
+void MatchingEngine::Gateway::fan_out(void (*shard_query)(size_t, SymbolId, const OrderBook&, void*), void* context) {
+    // Every shard gets its event before waiting on any, so they run at once
+    fan_out_sequences_.resize(engine_.shards_.size());
+    for (auto& shard : engine_.shards_) {
+        int64_t sequence = shard->ring.claim();
+        EngineEvent& event = shard->ring[sequence];
+        event.type = EngineEvent::Type::QUERY_SHARD;
+        event.gateway = id_;
+        event.symbol = SymbolDirectory::kNoSymbol;
+        event.shard_query = shard_query;
+        event.context = context;
+        shard->ring.publish(sequence);
+        fan_out_sequences_[shard->index] = sequence;
+    }
+
+    IdleBackoff backoff(true);
+    for (auto& shard : engine_.shards_) {
+        while (shard->matched.get() < fan_out_sequences_[shard->index]) backoff.pause();
+    }
+}
+
+OrderResult MatchingEngine::Gateway::add_order(SymbolId symbol, Price price, Quantity quantity, Side side, TimeInForce tif) {
+    EngineEvent& event = claim(EngineEvent::Type::ADD_ORDER, symbol);
+    event.order = OrderRequest{price, quantity, side, OrderType::LIMIT, tif, OrderBook::kUnprotected};
+    return submit().result;
+}
+
+OrderResult MatchingEngine::Gateway::add_market_order(SymbolId symbol, Quantity quantity, Side side, uint32_t protection_ticks) {
+    EngineEvent& event = claim(EngineEvent::Type::ADD_ORDER, symbol);
+    event.order = OrderRequest{0, quantity, side, OrderType::MARKET, TimeInForce::IOC, protection_ticks};
+    return submit().result;
+}
+
+void MatchingEngine::Gateway::add_orders(SymbolId symbol, const std::vector<OrderRequest>& requests, std::vector<OrderResult>& results) {
+    results.resize(requests.size());
+    batch_requests_ = &requests;
+    batch_results_ = &results;
+
+    claim(EngineEvent::Type::ADD_ORDERS, symbol);
+    submit();
+}
+
+// An ID naming no symbol can't be resting anywhere, so it is answered here
+// rather than sent through the pipeline
+
+bool MatchingEngine::Gateway::cancel_order(OrderId order_id) {
+    SymbolId symbol = SymbolDirectory::symbol_of(order_id);
+    if (!engine_.symbols_.contains(symbol)) return false;
+
+    EngineEvent& event = claim(EngineEvent::Type::CANCEL, symbol);
+    event.order_id = SymbolDirectory::local_id(order_id);
+    return submit().success;
+}
+
+bool MatchingEngine::Gateway::amend_order(OrderId order_id, Price price, Quantity quantity) {
+    SymbolId symbol = SymbolDirectory::symbol_of(order_id);
+    if (!engine_.symbols_.contains(symbol)) return false;
+
+    EngineEvent& event = claim(EngineEvent::Type::AMEND, symbol);
+    event.order_id = SymbolDirectory::local_id(order_id);
+    event.order.price = price;
+    event.order.quantity = quantity;
+    return submit().success;
+}
+
+MarketData MatchingEngine::Gateway::market_data(SymbolId symbol) const {
+    // Anything already answered has been matched; wait for the symbol's
+    // publisher to get that far so callers read their own writes
+    const Shard& shard = *engine_.shards_[engine_.shard_of(symbol)];
+    int64_t target = shard.matched.get();
+    IdleBackoff backoff(true);
+    while (shard.published.get() < target) backoff.pause();
+
+    const PublishedMarketData& published = engine_.published_market_data_[symbol];
+    MarketData snapshot;
+    uint64_t words[kMarketDataWords];
+    while (true) {
+        uint64_t version = published.version.load(std::memory_order_acquire);
+        if (version & 1) {
+            cpu_relax();
+            continue;
+        }
+        for (size_t i = 0; i < kMarketDataWords; ++i) {
+            words[i] = published.words[i].load(std::memory_order_relaxed);
+        }
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (published.version.load(std::memory_order_relaxed) == version) break;
+    }
+    std::memcpy(&snapshot, words, sizeof(snapshot));
+    return snapshot;
+}
+
+// --- MatchingEngine ---
+
+MatchingEngine::Shard::Shard(size_t index, size_t ring_capacity, std::unique_ptr<InputJournal> journal)
+    : index(index)
+    , ring(ring_capacity)
+    , journal(std::move(journal))
+    , journal_barrier(ring)
+    , match_barrier(ring, this->journal ? std::vector<const Sequence*>{&journaled} : std::vector<const Sequence*>{})
+    , publish_barrier(ring, {&matched})
+{
+}
+
+MatchingEngine::MatchingEngine(SymbolDirectory& symbols, const MatchingEngineConfig& config)
+    : symbols_(symbols)
+    , config_(config)
+    , published_market_data_(new PublishedMarketData[symbols.size()])
+{
+    size_t shard_count = std::max<size_t>(1, config_.shards);
+
+    // Each shard journals its own inputs in its own order; all or none
+    std::vector<std::unique_ptr<InputJournal>> journals(shard_count);
+    if (!config_.journal_path.empty()) {
+        journaling_ = true;
+        for (size_t i = 0; i < shard_count && journaling_; ++i) {
+            std::string path = config_.journal_path;
+            if (shard_count > 1) path += "." + std::to_string(i);
+            journals[i].reset(new InputJournal());
+            journaling_ = journals[i]->open(path);
+        }
+        if (!journaling_) {
+            for (auto& journal : journals) journal.reset();
+        }
+    }
+
+    for (size_t i = 0; i < shard_count; ++i) {
+        shards_.emplace_back(new Shard(i, config_.ring_capacity, std::move(journals[i])));
+    }
+    for (SymbolId symbol = 0; symbol < symbols_.size(); ++symbol) {
+        shards_[shard_of(symbol)]->symbols.push_back(symbol);
+    }
+
+    for (auto& shard : shards_) {
+        // The publisher trails every other stage
+        shard->ring.add_gating_sequence(shard->published);
+
+        shard->market_data.resize(shard->symbols.size());
+        shard->is_touched.resize(shard->symbols.size(), false);
+        for (SymbolId symbol : shard->symbols) {
+            summarize_book(symbols_.book(symbol), shard->market_data[symbol / shard_count]);
+            store_market_data(*shard, symbol);
+        }
+    }
+}
+
+MatchingEngine::~MatchingEngine() {
+    stop();
+}
+
+MatchingEngine::Gateway& MatchingEngine::add_gateway() {
+    uint32_t id = static_cast<uint32_t>(gateways_.size());
+    gateways_.emplace_back(new Gateway(*this, id));
+    return *gateways_.back();
+}
+
+void MatchingEngine::start() {
+    if (running_.exchange(true)) return;
+    for (auto& shard : shards_) {
+        run_shard(*shard);
+    }
+}
+
+void MatchingEngine::stop() {
+    if (!running_.exchange(false)) return;
+    for (auto& thread : threads_) {
+        thread.join();
+    }
+    threads_.clear();
+}
+
+void MatchingEngine::run_shard(Shard& shard) {
+    if (journaling_) {
+        threads_.emplace_back([this, &shard] {
+            run_stage(shard, shard.journaled, shard.journal_barrier, false, [this, &shard](int64_t first, int64_t last) {
+                if (shard.halted()) return;
+                for (int64_t sequence = first; sequence <= last; ++sequence) {
+                    journal(shard, sequence, shard.ring[sequence]);
+                }
+                // Published before this batch is released to the matcher,
+                // which then fails these events rather than apply them
+                if (!shard.journal->flush()) {
+                    shard.journal_failed_at.store(first, std::memory_order_release);
+                    LOG_ERROR("Input journal {} failed; shard {} is not accepting input",
+                              shard.journal->path(), shard.index);
+                }
+            });
+        });
+    }
+
+    threads_.emplace_back([this, &shard] {
+        int cpu = config_.cpu >= 0 ? config_.cpu + static_cast<int>(shard.index) : -1;
+        if (cpu >= 0 && !pin_current_thread(cpu)) {
+            LOG_WARN("Could not pin shard {}'s matching thread to CPU {}", shard.index, cpu);
+        }
+        // A pinned matcher owns its core and never sleeps. Progress goes out
+        // per event so a gateway isn't held up by the rest of its batch.
+        run_stage(shard, shard.matched, shard.match_barrier, cpu >= 0, [this, &shard](int64_t first, int64_t last) {
+            for (int64_t sequence = first; sequence <= last; ++sequence) {
+                execute(shard, sequence, shard.ring[sequence]);
+                shard.matched.set(sequence);
+            }
+        });
+    });
+
+    threads_.emplace_back([this, &shard] {
+        run_stage(shard, shard.published, shard.publish_barrier, false, [this, &shard](int64_t first, int64_t last) {
+            publish(shard, first, last);
+        });
+    });
+}
+
+template<typename Handler>
+void MatchingEngine::run_stage(Shard& shard, Sequence& progress, const SequenceBarrier<EngineEvent>& barrier, bool never_sleep, Handler&& handler) {
+    IdleBackoff backoff(never_sleep);
+    int64_t next = progress.get() + 1;
+    while (true) {
+        int64_t available = barrier.available(next);
+        if (available >= next) {
+            handler(next, available);
+            progress.set(available);
+            next = available + 1;
+            backoff.reset();
+            continue;
+        }
+        // Gateways are idle by now, so nothing claimed is left unpublished
+        if (!running_.load(std::memory_order_acquire) && next > shard.ring.claimed()) break;
+        backoff.pause();
+    }
+}
+
+void MatchingEngine::journal(Shard& shard, int64_t sequence, const EngineEvent& event) {
+    auto order_record = [sequence, &event](const OrderRequest& order) {
+        InputRecord record{};
+        record.sequence = sequence;
+        record.symbol = event.symbol;
+        record.type = InputRecord::Type::ORDER;
+        record.price = order.price;
+        record.quantity = order.quantity;
+        record.protection_ticks = order.protection_ticks;
+        record.side = order.side;
+        record.order_type = order.type;
+        record.tif = order.tif;
+        return record;
+    };
+
+    switch (event.type) {
+        case EngineEvent::Type::ADD_ORDER:
+            shard.journal->append(order_record(event.order));
+            break;
+        case EngineEvent::Type::ADD_ORDERS:
+            for (const OrderRequest& order : *gateways_[event.gateway]->batch_requests_) {
+                shard.journal->append(order_record(order));
+            }
+            break;
+        case EngineEvent::Type::CANCEL:
+        case EngineEvent::Type::AMEND: {
+            InputRecord record{};
+            record.sequence = sequence;
+            record.symbol = event.symbol;
+            record.type = event.type == EngineEvent::Type::CANCEL ? InputRecord::Type::CANCEL : InputRecord::Type::AMEND;
+            record.order_id = event.order_id;
+            if (record.type == InputRecord::Type::AMEND) {
+                record.price = event.order.price;
+                record.quantity = event.order.quantity;
+            }
+            shard.journal->append(record);
+            break;
+        }
+        case EngineEvent::Type::QUERY:
+        case EngineEvent::Type::QUERY_SHARD:
+            break;  // Reads change nothing
+    }
+}
+
+void MatchingEngine::execute(Shard& shard, int64_t sequence, EngineEvent& event) {
+    // Every shard runs its part of a fan-out at once, so none of them may
+    // touch the gateway's response
+    if (event.type == EngineEvent::Type::QUERY_SHARD) {
+        for (SymbolId symbol : shard.symbols) {
+            event.shard_query(shard.index, symbol, symbols_.book(symbol), event.context);
+        }
+        return;
+    }
+
+    Gateway& gateway = *gateways_[event.gateway];
+    EngineResponse& response = gateway.response_;
+    response = EngineResponse{};
+
+    OrderBook& order_book = symbols_.book(event.symbol);
+    MarketData& book = event.book;
+    book.last_trade_price = 0;
+    book.traded_volume = 0;
+    gateway.trades_.clear();
+
+    // Input the journal lost is refused, queries are still answered
+    if (event.type != EngineEvent::Type::QUERY &&
+        sequence >= shard.journal_failed_at.load(std::memory_order_acquire)) {
+        response.halted = true;
+        summarize_book(order_book, book);
+        response.order_count = book.order_count;
+        return;
+    }
+    auto sink = [&gateway, &book, symbol = event.symbol](const Trade& trade) {
+        Trade& out = gateway.trades_.emplace_back(trade);
+        out.buyer_id = SymbolDirectory::to_global(symbol, trade.buyer_id);
+        out.seller_id = SymbolDirectory::to_global(symbol, trade.seller_id);
+        book.last_trade_price = trade.price;
+        book.traded_volume += trade.quantity;
+    };
+
+    try {
+        switch (event.type) {
+            case EngineEvent::Type::ADD_ORDER: {
+                const OrderRequest& order = event.order;
+                response.result = order.type == OrderType::MARKET
+                    ? order_book.add_market_order(order.quantity, order.side, order.protection_ticks, sink)
+                    : order_book.add_order(order.price, order.quantity, order.side, order.tif, sink);
+                response.result.order_id = SymbolDirectory::to_global(event.symbol, response.result.order_id);
+                break;
+            }
+            case EngineEvent::Type::ADD_ORDERS: {
+                std::vector<OrderResult>& results = *gateway.batch_results_;
+                order_book.add_orders(gateway.batch_requests_->data(), gateway.batch_requests_->size(),
+                                      results.data(), sink);
+                for (OrderResult& result : results) {
+                    result.order_id = SymbolDirectory::to_global(event.symbol, result.order_id);
+                }
+                break;
+            }
+            case EngineEvent::Type::CANCEL:
+                response.success = order_book.cancel_order(event.order_id);
+                break;
+            case EngineEvent::Type::AMEND:
+                response.success = order_book.amend_order(event.order_id, event.order.price, event.order.quantity, sink);
+                break;
+            case EngineEvent::Type::QUERY:
+                event.query(order_book, event.context);
+                break;
+            case EngineEvent::Type::QUERY_SHARD:
+                break;
+        }
+    } catch (const std::exception& e) {
+        // The book throws before changing anything; hand the message back
+        gateway.error_ = e.what();
+        response.failed = true;
+    }
+
+    summarize_book(order_book, book);
+    response.order_count = book.order_count;
+}
+
+void MatchingEngine::publish(Shard& shard, int64_t first, int64_t last) {
+    // Each symbol's snapshot is published once per batch, however many of
+    // its events the batch held; only the trade totals need every one
+    for (int64_t sequence = first; sequence <= last; ++sequence) {
+        const EngineEvent& event = shard.ring[sequence];
+        if (event.type == EngineEvent::Type::QUERY_SHARD) continue;
+
+        size_t slot = event.symbol / shards_.size();
+        MarketData& market_data = shard.market_data[slot];
+        Price last_trade_price = market_data.last_trade_price;
+        uint64_t traded_volume = market_data.traded_volume;
+        if (event.book.traded_volume > 0) {
+            last_trade_price = event.book.last_trade_price;
+            traded_volume += event.book.traded_volume;
+        }
+        market_data = event.book;
+        market_data.sequence = sequence;
+        market_data.last_trade_price = last_trade_price;
+        market_data.traded_volume = traded_volume;
+
+        if (!shard.is_touched[slot]) {
+            shard.is_touched[slot] = true;
+            shard.touched.push_back(event.symbol);
+        }
+    }
+    for (SymbolId symbol : shard.touched) {
+        store_market_data(shard, symbol);
+        shard.is_touched[symbol / shards_.size()] = false;
+    }
+    shard.touched.clear();
+}
+
+void MatchingEngine::store_market_data(Shard& shard, SymbolId symbol) {
+    uint64_t words[kMarketDataWords];
+    std::memcpy(words, &shard.market_data[symbol / shards_.size()], sizeof(words));
+
+    PublishedMarketData& published = published_market_data_[symbol];
+    uint64_t version = published.version.load(std::memory_order_relaxed);
+    published.version.store(version + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    for (size_t i = 0; i < kMarketDataWords; ++i) {
+        published.words[i].store(words[i], std::memory_order_relaxed);
+    }
+    published.version.store(version + 2, std::memory_order_release);
+}
+
+}
@@ -1,129 +1,66 @@
 #include "../include/order_book.hpp"
 #include <iostream>
 #include <iomanip>
-#include <algorithm>
 
 namespace trading {
 
-std::vector<Trade> OrderBook::add_order(Price price, Quantity quantity, Side side) {
-    Order* order = new Order(next_order_id_++, price, quantity, side);
-        orders_[order->id] = order;
-        std::vector<Trade> trades = match_order(order);
-        if (!order->is_fully_filled()) {
-        add_to_book(order);
-    } else {
-        orders_.erase(order->id);
-        delete order;
-    }
-    
+std::vector<Trade> OrderBook::add_order(Price price, Quantity quantity, Side side, TimeInForce tif) {
+    std::vector<Trade> trades;
+    add_order(price, quantity, side, tif, [&trades](const Trade& trade) { trades.push_back(trade); });
     return trades;
 }
 
+std::vector<Trade> OrderBook::add_market_order(Quantity quantity, Side side, uint32_t protection_ticks) {
+    std::vector<Trade> trades;
+    add_market_order(quantity, side, protection_ticks, [&trades](const Trade& trade) { trades.push_back(trade); });
+    return trades;
+}
+
+std::vector<OrderResult> OrderBook::add_orders(const std::vector<OrderRequest>& requests, std::vector<Trade>& trades) {
+    std::vector<OrderResult> results(requests.size());
+    add_orders(requests.data(), requests.size(), results.data(), [&trades](const Trade& trade) { trades.push_back(trade); });
+    return results;
+}
+
 bool OrderBook::cancel_order(OrderId order_id) {
-    auto it = orders_.find(order_id);
-    if (it == orders_.end()) {
+    Order* order = orders_.find(order_id);
+    if (order == nullptr) {
         return false;
     }
     
-    Order* order = it->second;
     remove_from_book(order);
-    orders_.erase(it);
-    delete order;
+    orders_.erase(order_id);
+    order_pool_.release(order);
     
     return true;
 }
 
-// --- Private Logic ---
-
-std::vector<Trade> OrderBook::match_order(Order* order) {
-    std::vector<Trade> local_trades;
-    
-    if (order->side == Side::BUY) {
-        match_against(order, asks_, local_trades);
-    } else {
-        match_against(order, bids_, local_trades);
-    }
-    
-    return local_trades;
+bool OrderBook::amend_order(OrderId order_id, Price new_price, Quantity new_quantity) {
+    return amend_order(order_id, new_price, new_quantity, [](const Trade&) {});
 }
 
+// --- Private Logic ---
 
-template<typename T>
-void OrderBook::match_against(Order* taker_order, T& opposite_side, std::vector<Trade>& trades) {
-    while (!taker_order->is_fully_filled() && !opposite_side.empty()) {
-        auto it = opposite_side.begin();
-        Price best_resting_price = it->first;
-        PriceLevel& price_level = it->second;
-
-        // Verify Price Cross (Marketability)
-        bool can_match = (taker_order->side == Side::BUY) ? (taker_order->price >= best_resting_price) 
-                                                          : (taker_order->price <= best_resting_price);
-        if (!can_match) break;
-
-        while (!taker_order->is_fully_filled() && !price_level.is_empty()) {
-            Order* maker_order = price_level.get_head();
-            Quantity fill_qty = std::min(taker_order->remaining_quantity(), maker_order->remaining_quantity());
-
-            // Generate Trade record
-            Trade trade(
-                taker_order->side == Side::BUY ? taker_order->id : maker_order->id,
-                taker_order->side == Side::SELL ? taker_order->id : maker_order->id,
-                best_resting_price,
-                fill_qty
-            );
-            
-            trades.push_back(trade);
-            trades_.push_back(trade);
-
-            // Update quantities
-            taker_order->fill(fill_qty);
-            maker_order->fill(fill_qty);
-            price_level.update_quantity(fill_qty);
-
-            if (maker_order->is_fully_filled()) {
-                price_level.remove_order(maker_order);
-                orders_.erase(maker_order->id);
-                delete maker_order;
-            }
-        }
-
-        if (price_level.is_empty()) {
-            opposite_side.erase(it);
-        }
-    }
+bool OrderBook::can_fill(Price price, Quantity quantity, Side side) const {
+    uint64_t available = (side == Side::BUY) ? asks_.quantity_up_to(price, quantity)
+                                             : bids_.quantity_up_to(price, quantity);
+    return available >= quantity;
 }
 
 void OrderBook::add_to_book(Order* order) {
+    Price price = OrderPool::info(order).price;
     if (order->side == Side::BUY) {
-        auto it = bids_.find(order->price);
-        if (it == bids_.end()) {
-            bids_.emplace(order->price, PriceLevel(order->price));
-            it = bids_.find(order->price);
-        }
-        it->second.add_order(order);
+        bids_.add_order(order, price);
     } else {
-        auto it = asks_.find(order->price);
-        if (it == asks_.end()) {
-            asks_.emplace(order->price, PriceLevel(order->price));
-            it = asks_.find(order->price);
-        }
-        it->second.add_order(order);
+        asks_.add_order(order, price);
     }
 }
 
 void OrderBook::remove_from_book(Order* order) {
     if (order->side == Side::BUY) {
-        auto it = bids_.find(order->price);
-        if (it != bids_.end()) {
-            it->second.remove_order(order);
-            if (it->second.is_empty()) bids_.erase(it);
-        }
+        bids_.remove_order(order);
     } else {
-        auto it = asks_.find(order->price);
-        if (it != asks_.end()) {
-            it->second.remove_order(order);
-            if (it->second.is_empty()) asks_.erase(it);
-        }
+        asks_.remove_order(order);
     }
 }
 
@@ -136,10 +73,10 @@ void OrderBook::print() const {
     
     std::cout << "\n--- ASKS (SELLS) ---\n";
     if (asks_.empty()) std::cout << "      (Empty)\n";
-    for (auto it = asks_.rbegin(); it != asks_.rend(); ++it) {
-        std::cout << "Price: " << std::setw(8) << it->first 
-                  << " | Qty: " << std::setw(6) << it->second.get_total_quantity() << "\n";
-    }
+    asks_.for_each_descending([](const PriceLevel& level) {
+        std::cout << "Price: " << std::setw(8) << level.get_price() 
+                  << " | Qty: " << std::setw(6) << level.get_total_quantity() << "\n";
+    });
 
     // Print Spread
     if (!bids_.empty() && !asks_.empty()) {
@@ -148,10 +85,10 @@ void OrderBook::print() const {
 
     std::cout << "\n--- BIDS (BUYS) ---\n";
     if (bids_.empty()) std::cout << "      (Empty)\n";
-    for (const auto& [price, level] : bids_) {
-        std::cout << "Price: " << std::setw(8) << price 
+    bids_.for_each_descending([](const PriceLevel& level) {
+        std::cout << "Price: " << std::setw(8) << level.get_price() 
                   << " | Qty: " << std::setw(6) << level.get_total_quantity() << "\n";
-    }
+    });
     
     std::cout << "\n" << std::string(40, '=') << "\n";
 }
@@ -0,0 +1,327 @@
+#include "../include/order_decoder.hpp"
+#include "../include/order_book.hpp"
+#include <charconv>
+
+namespace trading {
+
+namespace {
+
+constexpr uint64_t kMaxPriceDollars = 1000000;
+constexpr uint64_t kMaxQuantity = 1000000;
+constexpr int kMaxSkipDepth = 32;
+
+// A scalar value as it appeared in the body
+struct Token {
+    enum Kind : uint8_t { ABSENT, STRING, NUMBER, OTHER };
+    Kind kind = ABSENT;
+    std::string_view text;  // String contents without quotes, or the number's text
+};
+
+class Scanner {
+public:
+    explicit Scanner(std::string_view body)
+        : p_(body.data()), end_(body.data() + body.size()) {}
+
+    void skip_ws() {
+        while (p_ < end_ && (*p_ == ' ' || *p_ == '\t' || *p_ == '\n' || *p_ == '\r')) ++p_;
+    }
+
+    bool consume(char c) {
+        skip_ws();
+        if (p_ == end_ || *p_ != c) return false;
+        ++p_;
+        return true;
+    }
+
+    bool at_end() {
+        skip_ws();
+        return p_ == end_;
+    }
+
+    // String without escapes; anything escaped is left to the DOM path
+    bool read_string(std::string_view& out) {
+        if (!consume('"')) return false;
+        const char* start = p_;
+        while (p_ < end_ && *p_ != '"') {
+            if (*p_ == '\\' || static_cast<unsigned char>(*p_) < 0x20) return false;
+            ++p_;
+        }
+        if (p_ == end_) return false;
+        out = std::string_view(start, static_cast<size_t>(p_ - start));
+        ++p_;
+        return true;
+    }
+
+    // JSON number grammar: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+    bool read_number(std::string_view& out) {
+        skip_ws();
+        const char* start = p_;
+        if (p_ < end_ && *p_ == '-') ++p_;
+        if (p_ == end_ || !is_digit(*p_)) return false;
+        if (*p_ == '0') {
+            ++p_;
+        } else {
+            while (p_ < end_ && is_digit(*p_)) ++p_;
+        }
+        if (p_ < end_ && *p_ == '.') {
+            ++p_;
+            if (p_ == end_ || !is_digit(*p_)) return false;
+            while (p_ < end_ && is_digit(*p_)) ++p_;
+        }
+        if (p_ < end_ && (*p_ == 'e' || *p_ == 'E')) {
+            ++p_;
+            if (p_ < end_ && (*p_ == '+' || *p_ == '-')) ++p_;
+            if (p_ == end_ || !is_digit(*p_)) return false;
+            while (p_ < end_ && is_digit(*p_)) ++p_;
+        }
+        out = std::string_view(start, static_cast<size_t>(p_ - start));
+        return true;
+    }
+
+    bool read_token(Token& token) {
+        if (token.kind != Token::ABSENT) return false;  // Duplicate key
+        skip_ws();
+        if (p_ == end_) return false;
+        if (*p_ == '"') {
+            token.kind = Token::STRING;
+            return read_string(token.text);
+        }
+        if (*p_ == '-' || is_digit(*p_)) {
+            token.kind = Token::NUMBER;
+            return read_number(token.text);
+        }
+        token.kind = Token::OTHER;
+        return skip_value(0);
+    }
+
+    // Step over any value, for fields this schema does not use
+    bool skip_value(int depth) {
+        skip_ws();
+        if (p_ == end_ || depth > kMaxSkipDepth) return false;
+
+        std::string_view ignored;
+        switch (*p_) {
+            case '"': return read_string(ignored);
+            case 't': return literal("true");
+            case 'f': return literal("false");
+            case 'n': return literal("null");
+            case '{': case '[': {
+                char close = *p_ == '{' ? '}' : ']';
+                bool object = close == '}';
+                ++p_;
+                if (consume(close)) return true;
+                do {
+                    if (object && (!read_string(ignored) || !consume(':'))) return false;
+                    if (!skip_value(depth + 1)) return false;
+                } while (consume(','));
+                return consume(close);
+            }
+            default: return read_number(ignored);
+        }
+    }
+
+private:
+    static bool is_digit(char c) {
+        return c >= '0' && c <= '9';
+    }
+
+    bool literal(std::string_view word) {
+        if (static_cast<size_t>(end_ - p_) < word.size() || std::string_view(p_, word.size()) != word) return false;
+        p_ += word.size();
+        return true;
+    }
+
+    const char* p_;
+    const char* end_;
+};
+
+bool iequals(std::string_view a, std::string_view b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        char c = a[i];
+        if (c >= 'a' && c <= 'z') c = static_cast<char>(c - 'a' + 'A');
+        if (c != b[i]) return false;
+    }
+    return true;
+}
+
+// Non-negative integer with no fraction or exponent, at most `max`
+bool parse_unsigned(const Token& token, uint64_t max, uint64_t& value) {
+    if (token.kind != Token::NUMBER) return false;
+    auto result = std::from_chars(token.text.data(), token.text.data() + token.text.size(), value);
+    return result.ec == std::errc() && result.ptr == token.text.data() + token.text.size() && value <= max;
+}
+
+// Positive decimal dollars, at most kMaxPriceDollars, into cents (half up)
+bool parse_price_cents(const Token& token, Price& cents) {
+    if (token.kind != Token::NUMBER) return false;
+    std::string_view text = token.text;
+    if (text.front() == '-') return false;
+
+    size_t dot = text.find('.');
+    if (text.find_first_of("eE") != std::string_view::npos) return false;
+
+    std::string_view whole = text.substr(0, dot);
+    std::string_view fraction = dot == std::string_view::npos ? std::string_view() : text.substr(dot + 1);
+    if (whole.size() > 7) return false;
+
+    uint64_t dollars = 0;
+    for (char c : whole) dollars = dollars * 10 + static_cast<uint64_t>(c - '0');
+
+    bool fraction_nonzero = fraction.find_first_not_of('0') != std::string_view::npos;
+    if (dollars > kMaxPriceDollars || (dollars == kMaxPriceDollars && fraction_nonzero)) return false;
+    if (dollars == 0 && !fraction_nonzero) return false;
+
+    return decimal_to_cents(text, cents);
+}
+
+}
+
+bool decimal_to_cents(std::string_view text, Price& cents) {
+    size_t exponent_at = text.find_first_of("eE");
+    std::string_view mantissa = text.substr(0, exponent_at);
+    int exponent = 0;
+    if (exponent_at != std::string_view::npos) {
+        std::string_view digits = text.substr(exponent_at + 1);
+        if (!digits.empty() && digits.front() == '+') digits.remove_prefix(1);
+        auto result = std::from_chars(digits.data(), digits.data() + digits.size(), exponent);
+        if (result.ec != std::errc() || result.ptr != digits.data() + digits.size()) return false;
+    }
+    if (!mantissa.empty() && mantissa.front() == '-') return false;
+
+    // Each digit's power of ten once the exponent is applied: everything
+    // down to the hundredths makes up the cents, the thousandths round
+    size_t dot = mantissa.find('.');
+    long integer_digits = static_cast<long>(dot == std::string_view::npos ? mantissa.size() : dot);
+    long power = integer_digits - 1 + exponent;
+    uint64_t value = 0;
+    bool any_digit = false;
+    bool round_up = false;
+    for (size_t i = 0; i < mantissa.size(); ++i) {
+        if (i == dot) continue;
+        char c = mantissa[i];
+        if (c < '0' || c > '9') return false;
+        any_digit = true;
+        if (power >= -2) {
+            if (value > kMaxPriceDollars * 1000) return false;
+            value = value * 10 + static_cast<uint64_t>(c - '0');
+        } else if (power == -3) {
+            round_up = c >= '5';
+        }
+        --power;
+    }
+    if (!any_digit) return false;
+
+    // Short of the hundredths: the missing places are zeros
+    for (; power >= -2; --power) {
+        if (value > kMaxPriceDollars * 1000) return false;
+        value *= 10;
+    }
+    cents = static_cast<Price>(value + (round_up ? 1 : 0));
+    return true;
+}
+
+bool decode_order_request(std::string_view body, OrderRequest& req, double& price_received, SymbolField& symbol) {
+    Token type, price, quantity, side, tif, protection, symbol_token;
+
+    Scanner in(body);
+    if (!in.consume('{')) return false;
+    if (!in.consume('}')) {
+        do {
+            std::string_view key;
+            if (!in.read_string(key) || !in.consume(':')) return false;
+
+            bool ok;
+            if (key == "price") ok = in.read_token(price);
+            else if (key == "quantity") ok = in.read_token(quantity);
+            else if (key == "side") ok = in.read_token(side);
+            else if (key == "type") ok = in.read_token(type);
+            else if (key == "time_in_force") ok = in.read_token(tif);
+            else if (key == "protection_ticks") ok = in.read_token(protection);
+            else if (key == "symbol") ok = in.read_token(symbol_token);
+            else ok = in.skip_value(0);
+            if (!ok) return false;
+        } while (in.consume(','));
+        if (!in.consume('}')) return false;
+    }
+    if (!in.at_end()) return false;
+
+    // The checks parse_order_fields makes; any failure defers to it
+    OrderType order_type = OrderType::LIMIT;
+    if (type.kind != Token::ABSENT) {
+        if (type.kind != Token::STRING) return false;
+        if (iequals(type.text, "MARKET")) order_type = OrderType::MARKET;
+        else if (!iequals(type.text, "LIMIT")) return false;
+    }
+    bool is_market = order_type == OrderType::MARKET;
+
+    Price cents = 0;
+    price_received = 0;
+    if (!is_market) {
+        if (!parse_price_cents(price, cents)) return false;
+        auto result = std::from_chars(price.text.data(), price.text.data() + price.text.size(), price_received);
+        if (result.ec != std::errc()) return false;
+    }
+
+    uint64_t qty;
+    if (!parse_unsigned(quantity, kMaxQuantity, qty) || qty == 0) return false;
+
+    if (side.kind != Token::STRING) return false;
+    Side order_side;
+    if (iequals(side.text, "BUY")) order_side = Side::BUY;
+    else if (iequals(side.text, "SELL")) order_side = Side::SELL;
+    else return false;
+
+    TimeInForce time_in_force = TimeInForce::GTC;
+    if (tif.kind != Token::ABSENT) {
+        if (tif.kind != Token::STRING) return false;
+        if (iequals(tif.text, "IOC")) time_in_force = TimeInForce::IOC;
+        else if (iequals(tif.text, "FOK")) time_in_force = TimeInForce::FOK;
+        else if (!iequals(tif.text, "GTC")) return false;
+    }
+
+    uint64_t ticks = OrderBook::kUnprotected;
+    if (protection.kind != Token::ABSENT) {
+        if (!is_market || !parse_unsigned(protection, OrderBook::kUnprotected - 1, ticks)) return false;
+    }
+    if (is_market) {
+        if (tif.kind != Token::ABSENT && time_in_force != TimeInForce::IOC) return false;
+        time_in_force = TimeInForce::IOC;
+    }
+
+    // Whether the symbol exists is for the caller; only its form is checked
+    symbol = SymbolField();
+    if (symbol_token.kind == Token::STRING) {
+        symbol.kind = SymbolField::NAME;
+        symbol.name = symbol_token.text;
+    } else if (symbol_token.kind != Token::ABSENT) {
+        if (!parse_unsigned(symbol_token, UINT32_MAX, symbol.id)) return false;
+        symbol.kind = SymbolField::ID;
+    }
+
+    req = OrderRequest{cents, static_cast<Quantity>(qty), order_side, order_type, time_in_force, static_cast<uint32_t>(ticks)};
+    return true;
+}
+
+bool decode_cancel_request(std::string_view body, OrderId& order_id) {
+    Token id;
+
+    Scanner in(body);
+    if (!in.consume('{')) return false;
+    if (!in.consume('}')) {
+        do {
+            std::string_view key;
+            if (!in.read_string(key) || !in.consume(':')) return false;
+            if (!(key == "order_id" ? in.read_token(id) : in.skip_value(0))) return false;
+        } while (in.consume(','));
+        if (!in.consume('}')) return false;
+    }
+    if (!in.at_end()) return false;
+
+    uint64_t value;
+    if (!parse_unsigned(id, UINT64_MAX, value)) return false;
+    order_id = value;
+    return true;
+}
+
+}
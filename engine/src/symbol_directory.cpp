@@ -0,0 +1,24 @@
+#include "../include/symbol_directory.hpp"
+
+namespace trading {
+
+SymbolId SymbolDirectory::add(std::string_view name, size_t order_capacity) {
+    if (name.empty() || name.size() > kMaxNameLength) return kNoSymbol;
+
+    SymbolId existing = find(name);
+    if (existing != kNoSymbol) return existing;
+    if (books_.size() >= kMaxSymbols) return kNoSymbol;
+
+    SymbolId symbol = static_cast<SymbolId>(books_.size());
+    books_.emplace_back(new OrderBook(1, PriceLadder<Side::BUY>::kDefaultMaxLevels, order_capacity));
+    names_.emplace_back(name);
+    ids_.emplace(names_.back(), symbol);
+    return symbol;
+}
+
+SymbolId SymbolDirectory::find(std::string_view name) const {
+    auto it = ids_.find(name);
+    return it == ids_.end() ? kNoSymbol : it->second;
+}
+
+}
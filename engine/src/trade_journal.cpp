@@ -0,0 +1,156 @@
+#include "../include/trade_journal.hpp"
+#include <algorithm>
+
+#ifndef _WIN32
+    #include <fcntl.h>
+    #include <unistd.h>
+    #include <sys/mman.h>
+#endif
+
+namespace trading {
+
+namespace {
+
+size_t round_up_pow2(size_t n) {
+    size_t p = 1;
+    while (p < n) p <<= 1;
+    return p;
+}
+
+constexpr size_t kWindowBytes = TradeJournal::kSpillWindowRecords * sizeof(TradeRecord);
+
+}
+
+TradeJournal::TradeJournal(size_t capacity)
+    : capacity_(round_up_pow2(std::max<size_t>(capacity, 1)))
+    , next_seq_(1)
+    , spill_fd_(-1)
+    , window_(nullptr)
+    , window_first_(0)
+    , spilled_(0)
+{}
+
+TradeJournal::~TradeJournal() {
+    close_spill_file();
+}
+
+bool TradeJournal::open_spill_file(const std::string& path) {
+#ifdef _WIN32
+    (void)path;
+    return false;
+#else
+    if (next_seq_ > capacity_ + 1) return false;  // Records already dropped
+    close_spill_file();
+
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) return false;
+
+    spill_fd_ = fd;
+    spill_path_ = path;
+    spilled_ = 0;
+    if (!map_window(1)) {
+        close_spill_file();
+        return false;
+    }
+    return true;
+#endif
+}
+
+TradeSeq TradeJournal::first_available() const {
+    return spilled_ > 0 ? 1 : ring_first();
+}
+
+std::vector<TradeRecord> TradeJournal::last(size_t n) const {
+    TradeSeq from = n >= next_seq_ ? 1 : next_seq_ - n;
+    return since(from);
+}
+
+std::vector<TradeRecord> TradeJournal::since(TradeSeq seq, size_t max_count) const {
+    std::vector<TradeRecord> out;
+    seq = std::max(seq, first_available());
+    if (seq >= next_seq_) return out;
+
+    out.reserve(std::min<size_t>(next_seq_ - seq, max_count));
+
+    // Older records come from the spill file, the rest from the ring
+    TradeSeq ring_start = ring_first();
+    for (; seq < ring_start && out.size() < max_count; ++seq) {
+        TradeRecord record;
+        if (!read_spilled(seq, record)) break;
+        out.push_back(record);
+    }
+    seq = std::max(seq, ring_start);
+    for (; seq < next_seq_ && out.size() < max_count; ++seq) {
+        out.push_back(ring_[seq & (capacity_ - 1)]);
+    }
+    return out;
+}
+
+void TradeJournal::spill(const TradeRecord& record) {
+    if (record.sequence >= window_first_ + kSpillWindowRecords && !map_window(record.sequence)) {
+        // This record and every one after it is lost to the file, so the
+        // file no longer continues into the ring. Keep what it holds on disk
+        // but serve history from the ring alone from here on.
+        close_spill_file();
+        spilled_ = 0;
+        return;
+    }
+    window_[record.sequence - window_first_] = record;
+    spilled_ = record.sequence;
+}
+
+bool TradeJournal::map_window(TradeSeq first) {
+#ifdef _WIN32
+    (void)first;
+    return false;
+#else
+    if (window_ != nullptr) {
+        munmap(window_, kWindowBytes);
+        window_ = nullptr;
+    }
+
+    off_t offset = static_cast<off_t>((first - 1) * sizeof(TradeRecord));
+    if (ftruncate(spill_fd_, offset + static_cast<off_t>(kWindowBytes)) != 0) return false;
+
+    void* addr = mmap(nullptr, kWindowBytes, PROT_READ | PROT_WRITE, MAP_SHARED, spill_fd_, offset);
+    if (addr == MAP_FAILED) return false;
+
+    window_ = static_cast<TradeRecord*>(addr);
+    window_first_ = first;
+    return true;
+#endif
+}
+
+bool TradeJournal::read_spilled(TradeSeq seq, TradeRecord& out) const {
+#ifdef _WIN32
+    (void)seq;
+    (void)out;
+    return false;
+#else
+    if (seq == 0 || seq > spilled_) return false;
+    if (window_ != nullptr && seq >= window_first_) {
+        out = window_[seq - window_first_];
+        return true;
+    }
+    off_t offset = static_cast<off_t>((seq - 1) * sizeof(TradeRecord));
+    return pread(spill_fd_, &out, sizeof(out), offset) == static_cast<ssize_t>(sizeof(out));
+#endif
+}
+
+void TradeJournal::close_spill_file() {
+#ifndef _WIN32
+    if (window_ != nullptr) {
+        munmap(window_, kWindowBytes);
+        window_ = nullptr;
+    }
+    if (spill_fd_ >= 0) {
+        // Drop the unused tail of the last window; if this fails the tail is just zeroes
+        int rc = ftruncate(spill_fd_, static_cast<off_t>(spilled_ * sizeof(TradeRecord)));
+        (void)rc;
+        ::close(spill_fd_);
+        spill_fd_ = -1;
+    }
+#endif
+}
+
+}
@@ -0,0 +1,98 @@
+#include <vector>
+#include <stdexcept>
+#include "test.hpp"
+#include "../include/order_book.hpp"
+
+using namespace trading;
+
+namespace {
+
+// Seller of each trade a buy at `price` for `quantity` generates, in order
+std::vector<OrderId> sellers_hit(OrderBook& book, Price price, Quantity quantity) {
+    std::vector<OrderId> sellers;
+    for (const Trade& trade : book.add_order(price, quantity, Side::BUY, TimeInForce::IOC)) {
+        sellers.push_back(trade.seller_id);
+    }
+    return sellers;
+}
+
+}
+
+TEST(amend_smaller_at_same_price_keeps_priority) {
+    OrderBook book;
+    book.add_order(10000, 5, Side::SELL);  // 1
+    book.add_order(10000, 5, Side::SELL);  // 2
+    CHECK(book.amend_order(1, 10000, 3));
+    CHECK(sellers_hit(book, 10000, 4) == (std::vector<OrderId>{1, 2}));
+    CHECK_EQ(book.get_order_count(), size_t(1));
+}
+
+TEST(amend_larger_at_same_price_loses_priority) {
+    OrderBook book;
+    book.add_order(10000, 5, Side::SELL);  // 1
+    book.add_order(10000, 5, Side::SELL);  // 2
+    CHECK(book.amend_order(1, 10000, 8));
+    CHECK(sellers_hit(book, 10000, 6) == (std::vector<OrderId>{2, 1}));
+}
+
+TEST(amend_to_new_price_goes_to_back_of_level) {
+    OrderBook book;
+    book.add_order(10100, 5, Side::SELL);  // 1
+    book.add_order(10000, 5, Side::SELL);  // 2
+    CHECK(book.amend_order(2, 10100, 5));
+    CHECK_EQ(book.get_best_ask(), Price(10100));
+    CHECK_EQ(book.get_ask_level_count(), size_t(1));
+    CHECK(sellers_hit(book, 10100, 10) == (std::vector<OrderId>{1, 2}));
+}
+
+TEST(amend_across_the_spread_matches) {
+    OrderBook book;
+    book.add_order(10000, 5, Side::SELL);  // 1
+    book.add_order(9900, 8, Side::BUY);    // 2
+    std::vector<Trade> trades;
+    CHECK(book.amend_order(2, 10000, 8, [&trades](const Trade& trade) { trades.push_back(trade); }));
+    REQUIRE(trades.size() == 1);
+    CHECK_EQ(trades[0].buyer_id, OrderId(2));
+    CHECK_EQ(trades[0].seller_id, OrderId(1));
+    CHECK_EQ(trades[0].quantity, Quantity(5));
+    CHECK_EQ(trades[0].price, Price(10000));
+
+    // The remainder rests at the new price
+    CHECK_EQ(book.get_best_bid(), Price(10000));
+    CHECK_EQ(book.get_best_ask(), Price(0));
+    CHECK_EQ(book.get_order_count(), size_t(1));
+}
+
+TEST(amend_at_or_below_filled_cancels) {
+    OrderBook book;
+    book.add_order(10000, 10, Side::SELL);  // 1
+    book.add_order(10000, 4, Side::BUY);    // 2, fills 4 of order 1
+    CHECK(book.amend_order(1, 10000, 4));
+    CHECK_EQ(book.get_order_count(), size_t(0));
+    CHECK(!book.amend_order(1, 10000, 4));
+    CHECK(!book.amend_order(99, 10000, 4));
+}
+
+TEST(amend_price_checked_without_the_order) {
+    OrderBook book(1, 4096);
+    book.add_order(10000, 5, Side::BUY);   // 1
+    book.add_order(14000, 5, Side::BUY);   // 2
+    // With order 1 in place 14000..16000 is too wide; without it, it fits
+    CHECK(book.amend_order(1, 16000, 5));
+    CHECK_EQ(book.get_best_bid(), Price(16000));
+
+    // Order 2 is alone at 14000 but 16000..30000 still cannot fit: refused,
+    // and the book is as it was
+    CHECK_THROWS_AS(book.amend_order(2, 30000, 5), std::out_of_range);
+    CHECK_EQ(book.get_bid_level_count(), size_t(2));
+    CHECK_EQ(book.get_order_count(), size_t(2));
+
+    // A refused order sharing its level keeps its place too
+    book.add_order(14000, 5, Side::BUY);   // 3
+    CHECK_THROWS_AS(book.amend_order(2, 30000, 5), std::out_of_range);
+    std::vector<OrderId> buyers;
+    for (const Trade& trade : book.add_order(14000, 20, Side::SELL)) {
+        buyers.push_back(trade.buyer_id);
+    }
+    CHECK(buyers == (std::vector<OrderId>{1, 2, 3}));
+}
@@ -0,0 +1,111 @@
+#include <vector>
+#include <string>
+#include <algorithm>
+#include "test.hpp"
+#include "loopback.hpp"
+#include "../include/order_book.hpp"
+#include "../include/nlohmann/json.hpp"
+
+using namespace trading;
+using json = nlohmann::json;
+
+namespace {
+
+OrderRequest limit(Price price, Quantity quantity, Side side, TimeInForce tif = TimeInForce::GTC) {
+    return OrderRequest{price, quantity, side, OrderType::LIMIT, tif, OrderBook::kUnprotected};
+}
+
+OrderRequest market(Quantity quantity, Side side) {
+    return OrderRequest{0, quantity, side, OrderType::MARKET, TimeInForce::IOC, OrderBook::kUnprotected};
+}
+
+}
+
+TEST(batch_results_and_trades_line_up) {
+    OrderBook book(5);
+    book.add_order(10000, 5, Side::SELL);  // 1
+    book.add_order(10100, 5, Side::SELL);  // 2
+
+    std::vector<Trade> trades;
+    std::vector<OrderResult> results = book.add_orders({
+        limit(10000, 3, Side::BUY),                     // 3: takes 3 from 1
+        limit(10003, 1, Side::BUY),                     // off the tick grid
+        limit(9900, 2, Side::BUY),                      // 4: rests
+        market(3, Side::SELL),                          // 5: takes 4's 2, cancels 1
+        limit(10100, 20, Side::BUY, TimeInForce::FOK),  // cannot fill
+        limit(10100, 5, Side::BUY, TimeInForce::IOC),   // 6: 1's last 2, then 3 of 2
+    }, trades);
+
+    REQUIRE(results.size() == 6);
+    CHECK_EQ(results[0].order_id, OrderId(3));
+    CHECK_EQ(results[0].status, OrderStatus::FILLED);
+    CHECK_EQ(results[1].order_id, OrderId(0));
+    CHECK_EQ(results[1].status, OrderStatus::REJECTED);
+    CHECK_EQ(results[2].order_id, OrderId(4));
+    CHECK_EQ(results[2].status, OrderStatus::NEW);
+    CHECK_EQ(results[2].resting_quantity, Quantity(2));
+    CHECK_EQ(results[3].order_id, OrderId(5));
+    CHECK_EQ(results[3].status, OrderStatus::CANCELLED);
+    CHECK_EQ(results[3].filled_quantity, Quantity(2));
+    CHECK_EQ(results[4].order_id, OrderId(0));
+    CHECK_EQ(results[4].status, OrderStatus::REJECTED);
+    CHECK_EQ(results[5].order_id, OrderId(6));
+    CHECK_EQ(results[5].status, OrderStatus::FILLED);
+
+    // Trades come in execution order, each taker's as one run, so every
+    // result's fills are the trades whose higher ID is its own
+    size_t next = 0;
+    for (const OrderResult& result : results) {
+        Quantity filled = 0;
+        while (result.order_id != 0 && next < trades.size() &&
+               std::max(trades[next].buyer_id, trades[next].seller_id) == result.order_id) {
+            filled += trades[next++].quantity;
+        }
+        CHECK_EQ(filled, result.filled_quantity);
+    }
+    CHECK_EQ(next, trades.size());
+    REQUIRE(trades.size() == 4);
+    CHECK_EQ(trades[2].seller_id, OrderId(1));
+    CHECK_EQ(trades[2].price, Price(10000));
+    CHECK_EQ(trades[3].seller_id, OrderId(2));
+    CHECK_EQ(trades[3].price, Price(10100));
+}
+
+TEST(batch_over_http_reports_each_entry) {
+    test::LoopbackEngine engine;
+    std::string body;
+    REQUIRE(engine.request("POST", "/order", R"({"price":100.00,"quantity":5,"side":"SELL"})", body) == 200);
+
+    int status = engine.request("POST", "/orders", R"([
+        {"price":100.00,"quantity":3,"side":"BUY"},
+        {"price":-1,"quantity":3,"side":"BUY"},
+        {"price":99.00,"quantity":4,"side":"BUY"},
+        {"type":"MARKET","quantity":6,"side":"SELL"},
+        {"type":"MARKET","quantity":1,"side":"SELL","time_in_force":"FOK"}
+    ])", body);
+    REQUIRE(status == 200);
+    json response = json::parse(body);
+    CHECK_EQ(response["accepted"].get<int>(), 3);
+    CHECK_EQ(response["invalid"].get<int>(), 2);
+    CHECK_EQ(response["order_count"].get<int>(), 1);  // Order 1's last 2
+
+    const json& results = response["results"];
+    REQUIRE(results.size() == 5);
+    CHECK_EQ(results[0]["order_status"].get<std::string>(), "FILLED");
+    REQUIRE(results[0]["trades"].size() == 1);
+    CHECK_EQ(results[0]["trades"][0]["seller_id"].get<OrderId>(), OrderId(1));
+    CHECK_EQ(results[0]["trades"][0]["quantity"].get<int>(), 3);
+    CHECK(results[1].contains("error"));
+    CHECK_EQ(results[1]["index"].get<int>(), 1);
+    CHECK_EQ(results[2]["order_status"].get<std::string>(), "NEW");
+    CHECK(results[2]["trades"].empty());
+
+    // The market sell meets only the resting buy, as the taker
+    const json& sweep = results[3];
+    CHECK_EQ(sweep["filled_quantity"].get<int>(), 4);
+    CHECK_EQ(sweep["order_status"].get<std::string>(), "CANCELLED");
+    REQUIRE(sweep["trades"].size() == 1);
+    CHECK_EQ(sweep["trades"][0]["buyer_id"].get<OrderId>(), results[2]["order_id"].get<OrderId>());
+    CHECK_EQ(sweep["trades"][0]["seller_id"].get<OrderId>(), sweep["order_id"].get<OrderId>());
+    CHECK(results[4].contains("error"));
+}
@@ -0,0 +1,217 @@
+#include <string>
+#include <vector>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include "test.hpp"
+#include "loopback.hpp"
+#include "../include/binary_client.hpp"
+
+using namespace trading;
+using namespace trading::wire;
+
+namespace {
+
+template<typename Message>
+std::string bytes_of(const Message& message) {
+    return std::string(reinterpret_cast<const char*>(&message), sizeof(message));
+}
+
+NewOrder new_order(uint64_t tag, const OrderEntry& entry) {
+    return NewOrder{header_for<NewOrder>(MessageType::NEW_ORDER), tag, 0, entry};
+}
+
+}
+
+TEST(binary_orders_fills_and_cancels) {
+    test::LoopbackEngine engine({"AAPL", "MSFT"});
+    BinaryClient client;
+    REQUIRE(client.connect("127.0.0.1", engine.binary_port()));
+
+    SymbolReport symbol;
+    REQUIRE(client.lookup_symbol("MSFT", symbol));
+    CHECK(symbol.found);
+    CHECK_EQ(symbol.symbol, uint32_t(1));
+    REQUIRE(client.lookup_symbol("NOPE", symbol));
+    CHECK(!symbol.found);
+
+    ExecutionReport report;
+    std::vector<Fill> fills;
+    REQUIRE(client.new_order(1, BinaryClient::limit(10000, 10, Side::SELL), report, fills));
+    CHECK_EQ(report.status, uint8_t(OrderStatus::NEW));
+    CHECK_EQ(report.resting_quantity, Quantity(10));
+    CHECK_EQ(SymbolDirectory::symbol_of(report.order_id), SymbolId(1));
+    OrderId maker = report.order_id;
+
+    REQUIRE(client.new_order(1, BinaryClient::limit(10000, 4, Side::BUY), report, fills));
+    CHECK_EQ(report.status, uint8_t(OrderStatus::FILLED));
+    CHECK_EQ(report.fill_count, uint32_t(1));
+    REQUIRE(fills.size() == 1);
+    CHECK_EQ(fills[0].buyer_id, report.order_id);
+    CHECK_EQ(fills[0].seller_id, maker);
+    CHECK_EQ(fills[0].quantity, Quantity(4));
+
+    AmendReport amend;
+    REQUIRE(client.amend(maker, 10100, 8, amend, fills));
+    CHECK(amend.amended);
+    REQUIRE(client.amend(maker + 1000, 10100, 8, amend, fills));
+    CHECK(!amend.amended);
+
+    CancelReport cancel;
+    REQUIRE(client.cancel(maker, cancel));
+    CHECK(cancel.cancelled);
+    REQUIRE(client.cancel(maker, cancel));
+    CHECK(!cancel.cancelled);
+}
+
+TEST(binary_rejects_each_bad_entry) {
+    test::LoopbackEngine engine;
+    BinaryClient client;
+    REQUIRE(client.connect("127.0.0.1", engine.binary_port()));
+
+    OrderEntry bad_side = BinaryClient::limit(10000, 1, Side::BUY);
+    bad_side.side = 7;
+    OrderEntry bad_type = BinaryClient::limit(10000, 1, Side::BUY);
+    bad_type.type = 9;
+    OrderEntry market_fok = BinaryClient::market(1, Side::BUY);
+    market_fok.time_in_force = static_cast<uint8_t>(TimeInForce::FOK);
+    OrderEntry protected_limit = BinaryClient::limit(10000, 1, Side::BUY);
+    protected_limit.protection_ticks = 5;
+
+    std::vector<OrderEntry> batch = {
+        BinaryClient::limit(0, 1, Side::BUY),
+        BinaryClient::limit(10000, 0, Side::BUY),
+        bad_side,
+        bad_type,
+        market_fok,
+        protected_limit,
+        BinaryClient::limit(10000, 1, Side::BUY),
+    };
+    std::vector<ExecutionReport> reports;
+    std::vector<Fill> fills;
+    REQUIRE(client.new_order_batch(0, batch, reports, fills));
+    REQUIRE(reports.size() == batch.size());
+    RejectReason expected[] = {RejectReason::INVALID_PRICE, RejectReason::INVALID_QUANTITY, RejectReason::INVALID_SIDE,
+                               RejectReason::INVALID_TYPE, RejectReason::INVALID_TIME_IN_FORCE,
+                               RejectReason::INVALID_PROTECTION, RejectReason::NONE};
+    for (size_t i = 0; i < batch.size(); ++i) {
+        CHECK_EQ(reports[i].reason, expected[i]);
+    }
+    CHECK_EQ(reports.back().status, uint8_t(OrderStatus::NEW));
+    OrderId resting = reports.back().order_id;
+
+    ExecutionReport report;
+    REQUIRE(client.new_order(99, BinaryClient::limit(10000, 1, Side::BUY), report, fills));
+    CHECK_EQ(report.reason, RejectReason::UNKNOWN_SYMBOL);
+
+    // Far outside the ladder window, so the book refuses it
+    REQUIRE(client.new_order(0, BinaryClient::limit(kMaxPrice, 1, Side::BUY), report, fills));
+    CHECK_EQ(report.reason, RejectReason::BOOK_REJECTED);
+
+    // With a second order at its level, moving the first one cannot shift
+    // the window to an off-ladder price
+    REQUIRE(client.new_order(0, BinaryClient::limit(10000, 1, Side::BUY), report, fills));
+    AmendReport amend;
+    REQUIRE(client.amend(resting, 0, 1, amend, fills));
+    CHECK_EQ(amend.reason, RejectReason::INVALID_PRICE);
+    REQUIRE(client.amend(resting, kMaxPrice, 1, amend, fills));
+    CHECK_EQ(amend.reason, RejectReason::BOOK_REJECTED);
+}
+
+TEST(binary_framing) {
+    test::LoopbackEngine engine;
+    test::RawSession session(engine.binary_port());
+    REQUIRE(session.ok());
+
+    // Two orders arriving in pieces, the split falling inside a header
+    std::string two = bytes_of(new_order(1, BinaryClient::limit(10000, 1, Side::BUY))) +
+                      bytes_of(new_order(2, BinaryClient::limit(10000, 1, Side::BUY)));
+    CHECK(session.send_bytes(two.substr(0, 2)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(session.send_bytes(two.substr(2, 40)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    CHECK(session.send_bytes(two.substr(42)));
+    ExecutionReport report;
+    REQUIRE(session.receive(report));
+    CHECK_EQ(report.client_tag, uint64_t(1));
+    REQUIRE(session.receive(report));
+    CHECK_EQ(report.client_tag, uint64_t(2));
+
+    // Unknown type: refused with its tag, the session carries on
+    Cancel unknown{MessageHeader{sizeof(Cancel), static_cast<MessageType>(77), kVersion}, 3, 0};
+    CHECK(session.send_bytes(bytes_of(unknown)));
+    Reject reject;
+    REQUIRE(session.receive(reject));
+    CHECK_EQ(reject.client_tag, uint64_t(3));
+    CHECK_EQ(reject.reason, RejectReason::UNKNOWN_MESSAGE);
+
+    // Another protocol version
+    Cancel old_version{MessageHeader{sizeof(Cancel), MessageType::CANCEL, kVersion - 1}, 4, 1};
+    CHECK(session.send_bytes(bytes_of(old_version)));
+    REQUIRE(session.receive(reject));
+    CHECK_EQ(reject.client_tag, uint64_t(4));
+    CHECK_EQ(reject.rejected_type, MessageType::CANCEL);
+    CHECK_EQ(reject.reason, RejectReason::UNSUPPORTED_VERSION);
+
+    // A known type of the wrong size
+    std::string padded = bytes_of(Cancel{MessageHeader{sizeof(Cancel) + 4, MessageType::CANCEL, kVersion}, 5, 1}) + "pad!";
+    CHECK(session.send_bytes(padded));
+    REQUIRE(session.receive(reject));
+    CHECK_EQ(reject.client_tag, uint64_t(5));
+    CHECK_EQ(reject.reason, RejectReason::MALFORMED_MESSAGE);
+
+    // Still in step: a well-formed cancel is answered
+    CHECK(session.send_bytes(bytes_of(Cancel{header_for<Cancel>(MessageType::CANCEL), 6, 999})));
+    CancelReport cancel;
+    REQUIRE(session.receive(cancel));
+    CHECK_EQ(cancel.client_tag, uint64_t(6));
+    CHECK(!cancel.cancelled);
+
+    // A length shorter than the header cannot be framed past: rejected, closed
+    CHECK(session.send_bytes(bytes_of(MessageHeader{2, MessageType::CANCEL, kVersion})));
+    REQUIRE(session.receive(reject));
+    CHECK_EQ(reject.reason, RejectReason::MALFORMED_MESSAGE);
+    CHECK(session.at_eof());
+}
+
+TEST(binary_input_waits_for_a_slow_reader) {
+    test::LoopbackEngine engine;
+    test::RawSession session(engine.binary_port());
+    REQUIRE(session.ok());
+
+    // Full batches of entries priced 0: each is refused with a report
+    // larger than itself, and the book is never touched
+    std::vector<OrderEntry> entries(kMaxBatchOrders, BinaryClient::limit(0, 1, Side::BUY));
+    size_t entry_bytes = entries.size() * sizeof(OrderEntry);
+    NewOrderBatch header{header_for<NewOrderBatch>(MessageType::NEW_ORDER_BATCH, entry_bytes), 1, 0,
+                         static_cast<uint16_t>(entries.size()), 0};
+    std::string batch = bytes_of(header) + std::string(reinterpret_cast<const char*>(entries.data()), entry_bytes);
+    constexpr size_t kBatches = 1000;
+
+    std::atomic<size_t> sent{0};
+    std::thread writer([&] {
+        for (size_t i = 0; i < kBatches; ++i) {
+            if (!session.send_bytes(batch)) return;
+            ++sent;
+        }
+    });
+
+    // The server stops reading, so the writer stalls part way
+    size_t last = 0;
+    for (int i = 0; i < 50; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        if (sent.load() == last) break;
+        last = sent.load();
+    }
+    CHECK(sent.load() < kBatches);
+
+    // Reading the reports lets every batch through
+    ExecutionReport report;
+    size_t reports = 0;
+    while (reports < kBatches * entries.size() && session.receive(report)) {
+        if (report.reason != RejectReason::INVALID_PRICE) break;
+        ++reports;
+    }
+    writer.join();
+    CHECK_EQ(reports, kBatches * entries.size());
+}
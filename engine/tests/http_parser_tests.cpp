@@ -0,0 +1,135 @@
+#include <string>
+#include "test.hpp"
+#include "../include/http_parser.hpp"
+
+using namespace trading;
+
+namespace {
+
+using Status = HttpParser::Status;
+
+const std::string kPost = "POST /order HTTP/1.1\r\nHost: x\r\nContent-Length: 5\r\n\r\nhello";
+
+}
+
+TEST(http_parser_one_byte_at_a_time) {
+    // Every prefix is incomplete, the CRLFCRLF split every way included, and
+    // the whole request parses once its last byte is in
+    HttpParser parser;
+    HttpRequest request;
+    for (size_t size = 0; size < kPost.size(); ++size) {
+        REQUIRE(parser.parse(kPost.data(), size, request) == Status::INCOMPLETE);
+    }
+    REQUIRE(parser.parse(kPost.data(), kPost.size(), request) == Status::COMPLETE);
+    CHECK_EQ(request.method, std::string_view("POST"));
+    CHECK_EQ(request.path, std::string_view("/order"));
+    CHECK_EQ(request.version, std::string_view("HTTP/1.1"));
+    CHECK_EQ(request.body, std::string_view("hello"));
+    CHECK_EQ(request.header("content-length"), std::string_view("5"));
+    CHECK_EQ(request.header("Host"), std::string_view("x"));
+    CHECK(request.keep_alive);
+    CHECK_EQ(parser.request_length(), kPost.size());
+}
+
+TEST(http_parser_follows_a_moving_buffer) {
+    // Views point at the latest buffer even when it moved between reads
+    HttpParser parser;
+    HttpRequest request;
+    std::string first = kPost.substr(0, kPost.find("\r\n\r\n") + 2);
+    REQUIRE(parser.parse(first.data(), first.size(), request) == Status::INCOMPLETE);
+    std::string second = kPost.substr(0, kPost.size() - 2);
+    REQUIRE(parser.parse(second.data(), second.size(), request) == Status::INCOMPLETE);
+    std::string whole = kPost;
+    REQUIRE(parser.parse(whole.data(), whole.size(), request) == Status::COMPLETE);
+    CHECK(request.body.data() == whole.data() + whole.size() - 5);
+    CHECK(request.method.data() == whole.data());
+}
+
+TEST(http_parser_pipelined_requests) {
+    std::string stream = "GET /health HTTP/1.1\r\n\r\n" + kPost + "GET /symbols HTTP/1.0\r\nConnection: keep-alive\r\n\r\n" +
+                         "GET /health HTTP/1.0\r\n\n";
+    HttpParser parser;
+    HttpRequest request;
+    size_t consumed = 0;
+    const char* paths[] = {"/health", "/order", "/symbols", "/health"};
+    bool keep_alive[] = {true, true, true, false};
+    for (size_t i = 0; i < 4; ++i) {
+        REQUIRE(parser.parse(stream.data() + consumed, stream.size() - consumed, request) == Status::COMPLETE);
+        CHECK_EQ(request.path, std::string_view(paths[i]));
+        CHECK_EQ(request.keep_alive, keep_alive[i]);
+        consumed += parser.request_length();
+        parser.reset();
+    }
+    CHECK_EQ(consumed, stream.size());
+    CHECK(parser.parse(stream.data() + consumed, 0, request) == Status::INCOMPLETE);
+}
+
+TEST(http_parser_connection_close) {
+    HttpParser parser;
+    HttpRequest request;
+    std::string close = "GET / HTTP/1.1\r\nConnection: Close\r\n\r\n";
+    REQUIRE(parser.parse(close.data(), close.size(), request) == Status::COMPLETE);
+    CHECK(!request.keep_alive);
+    CHECK_EQ(request.body.size(), size_t(0));
+}
+
+TEST(http_parser_rejections) {
+    struct Case {
+        std::string text;
+        int status;
+    };
+    Case cases[] = {
+        {"GARBAGE\r\n\r\n", 400},
+        {"GET /\r\n\r\n", 400},
+        {"GET / HTTP/1.1\r\nNoColon\r\n\r\n", 400},
+        {"POST / HTTP/1.1\r\nContent-Length: 5x\r\n\r\n", 400},
+        {"POST / HTTP/1.1\r\nContent-Length: 1048577\r\n\r\n", 413},
+        {"POST / HTTP/1.1\r\nTransfer-Encoding: chunked\r\n\r\n", 501},
+    };
+    for (const Case& c : cases) {
+        HttpParser parser;
+        HttpRequest request;
+        CHECK(parser.parse(c.text.data(), c.text.size(), request) == Status::ERROR);
+        CHECK_EQ(parser.error_status(), c.status);
+    }
+
+    std::string many = "GET / HTTP/1.1\r\n";
+    for (size_t i = 0; i <= HttpRequest::kMaxHeaders; ++i) many += "X-" + std::to_string(i) + ": 1\r\n";
+    many += "\r\n";
+    HttpParser parser;
+    HttpRequest request;
+    CHECK(parser.parse(many.data(), many.size(), request) == Status::ERROR);
+    CHECK_EQ(parser.error_status(), 400);
+
+    // Headers that never end are refused once they pass the limit
+    std::string endless = "GET / HTTP/1.1\r\nX-Pad: " + std::string(HttpParser::kMaxHeaderBytes, 'x');
+    parser.reset();
+    CHECK(parser.parse(endless.data(), HttpParser::kMaxHeaderBytes - 1, request) == Status::INCOMPLETE);
+    CHECK(parser.parse(endless.data(), endless.size(), request) == Status::ERROR);
+    CHECK_EQ(parser.error_status(), 400);
+}
+
+TEST(http_parser_names_its_body_limit) {
+    HttpRequest request;
+    std::string post = "POST / HTTP/1.1\r\nContent-Length: 2049\r\n\r\n";
+
+    HttpParser small(2048);
+    REQUIRE(small.parse(post.data(), post.size(), request) == Status::ERROR);
+    CHECK_EQ(small.error_status(), 413);
+    CHECK_EQ(std::string(small.error_body()), "{\"error\":\"Request body too large (max: 2 KiB)\"}");
+
+    HttpParser odd(1000);
+    REQUIRE(odd.parse(post.data(), post.size(), request) == Status::ERROR);
+    CHECK_EQ(std::string(odd.error_body()), "{\"error\":\"Request body too large (max: 1000 bytes)\"}");
+
+    HttpParser standard;
+    REQUIRE(standard.parse(post.data(), post.size(), request) == Status::INCOMPLETE);
+    std::string large = "POST / HTTP/1.1\r\nContent-Length: 2000000\r\n\r\n";
+    standard.reset();
+    REQUIRE(standard.parse(large.data(), large.size(), request) == Status::ERROR);
+    CHECK_EQ(std::string(standard.error_body()), "{\"error\":\"Request body too large (max: 1 MiB)\"}");
+
+    // The copy reports its own limit, not a pointer into the original
+    HttpParser copy = small;
+    CHECK_EQ(std::string(copy.error_body()), "{\"error\":\"Request body too large (max: 2 KiB)\"}");
+}
@@ -0,0 +1,60 @@
+#include <string>
+#include <thread>
+#include <chrono>
+#include <atomic>
+#include "test.hpp"
+#include "loopback.hpp"
+
+using namespace trading;
+
+TEST(http_pipelining_waits_for_a_slow_reader) {
+    test::LoopbackEngine engine;
+    // A hundred trades, so each GET /trades answers with all of them
+    MatchingEngine::Gateway& gateway = engine.gateway();
+    gateway.add_order(0, 10000, 100, Side::SELL, TimeInForce::GTC);
+    for (int i = 0; i < 100; ++i) {
+        gateway.add_order(0, 10000, 1, Side::BUY, TimeInForce::IOC);
+    }
+
+    test::RawSession session(engine.http_port());
+    REQUIRE(session.ok());
+
+    // Far more requests and responses than the server and the kernel buffer
+    // between them, sent without reading a single response. Padded requests
+    // stay under the per-connection request limit.
+    const std::string request = "GET /trades HTTP/1.1\r\nHost: localhost\r\nX-Pad: " + std::string(4000, 'x') + "\r\n\r\n";
+    constexpr size_t kRequests = 6000;
+
+    std::atomic<size_t> sent{0};
+    std::thread writer([&] {
+        for (size_t i = 0; i < kRequests; ++i) {
+            if (!session.send_bytes(request)) return;
+            ++sent;
+        }
+        if (session.send_bytes("GET /health HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n\r\n")) ++sent;
+    });
+
+    // The server stops reading, so the writer stalls part way
+    size_t last = 0;
+    for (int i = 0; i < 50; ++i) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+        if (sent.load() == last) break;
+        last = sent.load();
+    }
+    CHECK(sent.load() < kRequests);
+
+    // Reading the responses lets every request through, answered in full
+    const std::string status = "HTTP/1.1 200 ";
+    size_t responses = 0;
+    std::string tail;
+    char buffer[1 << 16];
+    ssize_t n;
+    while ((n = session.receive_some(buffer, sizeof(buffer))) > 0) {
+        std::string text = tail + std::string(buffer, static_cast<size_t>(n));
+        for (size_t at = text.find(status); at != std::string::npos; at = text.find(status, at + 1)) ++responses;
+        tail = text.substr(text.size() - (status.size() - 1));
+    }
+    writer.join();
+    CHECK_EQ(n, ssize_t(0));
+    CHECK_EQ(responses, kRequests + 1);
+}
@@ -0,0 +1,102 @@
+#include <string>
+#include <vector>
+#include <thread>
+#include <cstdio>
+#include <cstring>
+#include "test.hpp"
+#include "../include/logger.hpp"
+
+using namespace trading;
+
+namespace {
+
+// A record as LogRing sees one: its size first, then a marker byte
+bool put(LogRing& ring, uint32_t size, unsigned char marker) {
+    unsigned char* out = ring.reserve(size);
+    if (out == nullptr) return false;
+    std::memcpy(out, &size, sizeof(size));
+    out[sizeof(size)] = marker;
+    ring.commit(size);
+    return true;
+}
+
+std::vector<unsigned char> drain_markers(LogRing& ring) {
+    std::vector<unsigned char> markers;
+    ring.drain([&markers](const unsigned char* record, size_t) { markers.push_back(record[sizeof(uint32_t)]); });
+    return markers;
+}
+
+std::string read_all(FILE* file) {
+    std::string text;
+    std::rewind(file);
+    char buffer[4096];
+    size_t n;
+    while ((n = std::fread(buffer, 1, sizeof(buffer), file)) > 0) text.append(buffer, n);
+    return text;
+}
+
+}
+
+TEST(log_ring_pads_instead_of_wrapping_a_record) {
+    LogRing ring(64);
+    CHECK(put(ring, 24, 1));
+    CHECK(put(ring, 24, 2));
+    CHECK(drain_markers(ring) == std::vector<unsigned char>({1, 2}));
+
+    // 16 bytes are left before the end: padded over, the record starts at 0
+    CHECK(put(ring, 24, 3));
+    CHECK(put(ring, 24, 4));
+    // The next one needs the padding plus itself, which the unread
+    // records leave no room for until the consumer catches up
+    CHECK(!put(ring, 24, 5));
+    CHECK(drain_markers(ring) == std::vector<unsigned char>({3, 4}));
+    CHECK(put(ring, 24, 5));
+    CHECK(put(ring, 8, 6));
+    CHECK(drain_markers(ring) == std::vector<unsigned char>({5, 6}));
+    CHECK(drain_markers(ring).empty());
+}
+
+TEST(logger_counts_drops_and_retires_exited_threads) {
+    Logger& logger = Logger::instance();
+    size_t rings_before = logger.ring_count();
+
+    // Written while nothing drains, so the thread's ring fills and the
+    // rest are dropped; record sizes need not be known
+    constexpr size_t kAttempts = 4000;
+    std::string filler(Logger::kMaxStringArg, 'x');
+    std::thread producer([&] {
+        for (size_t i = 0; i < kAttempts; ++i) {
+            logger.write(LogLevel::WARN, "record {} {} {}", i, filler, i % 2 == 0);
+        }
+    });
+    producer.join();
+    CHECK_EQ(logger.ring_count(), rings_before + 1);
+
+    FILE* out = std::tmpfile();
+    REQUIRE(out != nullptr);
+    logger.start(out, LogLevel::DEBUG);
+    logger.stop();
+    CHECK_EQ(logger.ring_count(), rings_before);
+
+    // The records kept come out in order, followed by the count of the rest
+    std::string text = read_all(out);
+    std::fclose(out);
+    size_t kept = 0;
+    size_t pos = 0;
+    while (true) {
+        size_t end = text.find('\n', pos);
+        if (end == std::string::npos) break;
+        std::string line = text.substr(pos, end - pos);
+        if (line.find(" WARN  record ") == std::string::npos) break;
+        pos = end + 1;
+        std::string expected = " WARN  record " + std::to_string(kept) + " " + filler + (kept % 2 == 0 ? " true" : " false");
+        if (line.size() < expected.size() || line.compare(line.size() - expected.size(), expected.size(), expected) != 0) {
+            test::fail(__FILE__, __LINE__, "record " + std::to_string(kept) + " reads: " + line.substr(0, 80));
+            break;
+        }
+        ++kept;
+    }
+    REQUIRE(kept > 0);
+    REQUIRE(kept < kAttempts);
+    CHECK_EQ(text.substr(pos), "WARN  logger: dropped " + std::to_string(kAttempts - kept) + " records, ring full\n");
+}
@@ -0,0 +1,156 @@
+#include "loopback.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+namespace trading {
+namespace test {
+
+namespace {
+
+std::atomic<int> next_port{18000};
+
+int connect_to(int port) {
+    int fd = socket(AF_INET, SOCK_STREAM, 0);
+    if (fd < 0) return -1;
+    sockaddr_in address{};
+    address.sin_family = AF_INET;
+    address.sin_port = htons(static_cast<uint16_t>(port));
+    address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    if (connect(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) < 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+void wait_for_listener(int port) {
+    for (int attempt = 0; attempt < 500; ++attempt) {
+        int fd = connect_to(port);
+        if (fd >= 0) {
+            close(fd);
+            return;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+}
+
+}
+
+LoopbackEngine::LoopbackEngine(const std::vector<std::string>& symbols, size_t shards,
+                               const std::string& journal_path)
+    : http_port_(next_port.fetch_add(2))
+    , binary_port_(http_port_ + 1)
+{
+    for (const std::string& name : symbols) {
+        symbols_.add(name);
+    }
+    MatchingEngineConfig config;
+    config.shards = shards;
+    config.journal_path = journal_path;
+    engine_ = std::make_unique<MatchingEngine>(symbols_, config);
+    gateway_ = &engine_->add_gateway();
+    http_ = std::make_unique<HttpServer>(http_port_, engine_->add_gateway());
+    binary_ = std::make_unique<BinaryServer>(binary_port_, engine_->add_gateway());
+
+    engine_->start();
+    run(*http_, http_listener_);
+    run(*binary_, binary_listener_);
+    wait_for_listener(http_port_);
+    wait_for_listener(binary_port_);
+}
+
+LoopbackEngine::~LoopbackEngine() {
+    shut_down(*http_, http_listener_);
+    shut_down(*binary_, binary_listener_);
+    engine_->stop();
+}
+
+template<typename Server>
+void LoopbackEngine::run(Server& server, Listener& listener) {
+    listener.thread = std::thread([&server, &listener] {
+        server.start();
+        listener.done.store(true);
+    });
+}
+
+// stop() is a no-op until start() has marked the server running, which may
+// be just after the port began accepting, so keep asking until it returns
+template<typename Server>
+void LoopbackEngine::shut_down(Server& server, Listener& listener) {
+    while (!listener.done.load()) {
+        server.stop();
+        std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+    listener.thread.join();
+}
+
+int LoopbackEngine::request(const std::string& method, const std::string& target, const std::string& body,
+                            std::string& response_body) {
+    int fd = connect_to(http_port_);
+    if (fd < 0) return 0;
+
+    std::string request = method + " " + target + " HTTP/1.1\r\nHost: localhost\r\nConnection: close\r\n";
+    if (!body.empty()) {
+        request += "Content-Type: application/json\r\nContent-Length: " + std::to_string(body.size()) + "\r\n";
+    }
+    request += "\r\n" + body;
+    for (size_t sent = 0; sent < request.size();) {
+        ssize_t n = send(fd, request.data() + sent, request.size() - sent, 0);
+        if (n <= 0) {
+            close(fd);
+            return 0;
+        }
+        sent += static_cast<size_t>(n);
+    }
+
+    // Connection: close, so the response ends at EOF
+    std::string response;
+    char buffer[4096];
+    ssize_t n;
+    while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+        response.append(buffer, static_cast<size_t>(n));
+    }
+    close(fd);
+
+    size_t body_start = response.find("\r\n\r\n");
+    if (response.compare(0, 9, "HTTP/1.1 ") != 0 || body_start == std::string::npos) return 0;
+    response_body = response.substr(body_start + 4);
+    return std::atoi(response.c_str() + 9);
+}
+
+RawSession::RawSession(int port)
+    : fd_(connect_to(port))
+{
+    if (fd_ < 0) return;
+    timeval timeout{2, 0};
+    setsockopt(fd_, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof(timeout));
+}
+
+RawSession::~RawSession() {
+    if (fd_ >= 0) close(fd_);
+}
+
+bool RawSession::send_bytes(const std::string& bytes) {
+    for (size_t sent = 0; sent < bytes.size();) {
+        ssize_t n = send(fd_, bytes.data() + sent, bytes.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0) return false;
+        sent += static_cast<size_t>(n);
+    }
+    return true;
+}
+
+ssize_t RawSession::receive_some(char* data, size_t size) {
+    return recv(fd_, data, size, 0);
+}
+
+bool RawSession::at_eof() {
+    char byte;
+    return recv(fd_, &byte, 1, 0) == 0;
+}
+
+}
+}
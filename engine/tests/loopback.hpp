@@ -0,0 +1,105 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <memory>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <sys/types.h>
+#include "../include/symbol_directory.hpp"
+#include "../include/matching_engine.hpp"
+#include "../include/http_server.hpp"
+#include "../include/binary_server.hpp"
+
+namespace trading {
+namespace test {
+
+// A running MatchingEngine over the named symbols, with an HttpServer and a
+// BinaryServer on 127.0.0.1, for cases that go through the wire. Each
+// instance takes the next two ports from 18000 up, so cases never race a
+// previous listener for its port. A non-empty journal_path turns on the
+// engine's input journal stage.
+class LoopbackEngine {
+public:
+    explicit LoopbackEngine(const std::vector<std::string>& symbols = {"DEFAULT"}, size_t shards = 1,
+                            const std::string& journal_path = std::string());
+    ~LoopbackEngine();
+
+    LoopbackEngine(const LoopbackEngine&) = delete;
+    LoopbackEngine& operator=(const LoopbackEngine&) = delete;
+
+    int http_port() const { return http_port_; }
+    int binary_port() const { return binary_port_; }
+    const SymbolDirectory& symbols() const { return symbols_; }
+    bool journaling() const { return engine_->journaling(); }
+
+    // A gateway of its own, for calls straight into the engine
+    MatchingEngine::Gateway& gateway() { return *gateway_; }
+
+    // One HTTP request on a fresh connection; returns the status code, or 0
+    // if the exchange failed
+    int request(const std::string& method, const std::string& target, const std::string& body,
+                std::string& response_body);
+
+private:
+    struct Listener {
+        std::thread thread;
+        std::atomic<bool> done{false};
+    };
+
+    template<typename Server>
+    void run(Server& server, Listener& listener);
+    template<typename Server>
+    void shut_down(Server& server, Listener& listener);
+
+    SymbolDirectory symbols_;
+    std::unique_ptr<MatchingEngine> engine_;
+    MatchingEngine::Gateway* gateway_ = nullptr;
+    int http_port_;
+    int binary_port_;
+    std::unique_ptr<HttpServer> http_;
+    std::unique_ptr<BinaryServer> binary_;
+    Listener http_listener_;
+    Listener binary_listener_;
+};
+
+// A blocking connection that sends raw bytes, for framing and flow-control
+// cases the clients never produce. Receives give up after two seconds.
+class RawSession {
+public:
+    explicit RawSession(int port);
+    ~RawSession();
+
+    RawSession(const RawSession&) = delete;
+    RawSession& operator=(const RawSession&) = delete;
+
+    bool ok() const { return fd_ >= 0; }
+
+    bool send_bytes(const std::string& bytes);
+
+    // Whatever one recv returns: bytes read, 0 at EOF, -1 on error or timeout
+    ssize_t receive_some(char* data, size_t size);
+
+    // Exactly one message of type Message, or false
+    template<typename Message>
+    bool receive(Message& message) {
+        char buffer[sizeof(Message)];
+        size_t got = 0;
+        while (got < sizeof(buffer)) {
+            ssize_t n = receive_some(buffer + got, sizeof(buffer) - got);
+            if (n <= 0) return false;
+            got += static_cast<size_t>(n);
+        }
+        std::memcpy(&message, buffer, sizeof(message));
+        return true;
+    }
+
+    // True once the server has closed its end
+    bool at_eof();
+
+private:
+    int fd_;
+};
+
+}
+}
@@ -0,0 +1,50 @@
+#include <iostream>
+#include <cstring>
+#include <exception>
+#include "test.hpp"
+
+namespace trading {
+namespace test {
+
+namespace {
+size_t failures = 0;
+}
+
+std::vector<TestCase>& registry() {
+    static std::vector<TestCase> cases;
+    return cases;
+}
+
+void fail(const char* file, int line, const std::string& what) {
+    ++failures;
+    std::cout << "    " << file << ":" << line << ": " << what << std::endl;
+}
+
+}
+}
+
+using namespace trading::test;
+
+int main(int argc, char** argv) {
+    const char* filter = argc > 1 ? argv[1] : "";
+    size_t run = 0;
+    size_t failed = 0;
+    for (const TestCase& test : registry()) {
+        if (std::strstr(test.name, filter) == nullptr) continue;
+
+        size_t before = failures;
+        try {
+            test.run();
+        } catch (const Abort&) {
+        } catch (const std::exception& e) {
+            fail(test.name, 0, std::string("uncaught exception: ") + e.what());
+        }
+        ++run;
+        bool passed = failures == before;
+        if (!passed) ++failed;
+        std::cout << (passed ? "[ OK ] " : "[FAIL] ") << test.name << std::endl;
+    }
+
+    std::cout << run - failed << "/" << run << " tests passed" << std::endl;
+    return failed == 0 && run > 0 ? 0 : 1;
+}
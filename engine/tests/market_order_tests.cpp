@@ -0,0 +1,129 @@
+#include <vector>
+#include <string>
+#include "test.hpp"
+#include "loopback.hpp"
+#include "../include/order_book.hpp"
+#include "../include/nlohmann/json.hpp"
+
+using namespace trading;
+using json = nlohmann::json;
+
+namespace {
+
+struct TradeCollector {
+    std::vector<Trade>* trades;
+    void operator()(const Trade& trade) const { trades->push_back(trade); }
+};
+
+// Five at each of three prices, `step` apart, on the side opposite `taker`
+void seed_levels(OrderBook& book, Side taker, Price best, Price step) {
+    Side side = taker == Side::BUY ? Side::SELL : Side::BUY;
+    for (int i = 0; i < 3; ++i) {
+        book.add_order(taker == Side::BUY ? best + i * step : best - i * step, 5, side);
+    }
+}
+
+}
+
+TEST(market_order_sweeps_and_never_rests) {
+    OrderBook book;
+    seed_levels(book, Side::BUY, 10000, 100);
+    std::vector<Trade> trades;
+
+    // More than the whole ask side: it all fills, the rest is dropped
+    OrderResult result = book.add_market_order(20, Side::BUY, OrderBook::kUnprotected, TradeCollector{&trades});
+    CHECK_EQ(result.status, OrderStatus::CANCELLED);
+    CHECK_EQ(result.filled_quantity, Quantity(15));
+    CHECK_EQ(result.resting_quantity, Quantity(0));
+    CHECK_EQ(trades.size(), size_t(3));
+    CHECK_EQ(trades.back().price, Price(10200));
+    CHECK_EQ(book.get_order_count(), size_t(0));
+    CHECK_EQ(book.get_bid_level_count(), size_t(0));
+    CHECK(!book.cancel_order(result.order_id));
+}
+
+TEST(market_order_into_an_empty_side) {
+    OrderBook book;
+    book.add_order(9900, 5, Side::BUY);
+    std::vector<Trade> trades;
+
+    for (uint32_t protection : {OrderBook::kUnprotected, uint32_t(10)}) {
+        OrderResult result = book.add_market_order(5, Side::BUY, protection, TradeCollector{&trades});
+        CHECK_EQ(result.status, OrderStatus::CANCELLED);
+        CHECK_EQ(result.filled_quantity, Quantity(0));
+    }
+    CHECK(trades.empty());
+    CHECK_EQ(book.get_order_count(), size_t(1));
+    CHECK_EQ(book.get_bid_level_count(), size_t(1));
+    CHECK_EQ(book.get_ask_level_count(), size_t(0));
+    CHECK_EQ(book.get_best_bid(), Price(9900));
+}
+
+TEST(market_protection_band_from_the_arrival_best) {
+    // Buy: 100 ticks of 1 cent through 10000 reaches 10100, not 10200
+    OrderBook buy_book;
+    seed_levels(buy_book, Side::BUY, 10000, 100);
+    std::vector<Trade> trades;
+    OrderResult buy = buy_book.add_market_order(15, Side::BUY, 100, TradeCollector{&trades});
+    CHECK_EQ(buy.status, OrderStatus::CANCELLED);
+    CHECK_EQ(buy.filled_quantity, Quantity(10));
+    CHECK_EQ(trades.back().price, Price(10100));
+    CHECK_EQ(buy_book.get_best_ask(), Price(10200));
+
+    // Sell on a 5-cent grid: 30 ticks is 150 cents below 9900, so 9800 trades
+    // and 9700 does not
+    OrderBook sell_book(5);
+    seed_levels(sell_book, Side::SELL, 9900, 100);
+    trades.clear();
+    OrderResult sell = sell_book.add_market_order(15, Side::SELL, 30, TradeCollector{&trades});
+    CHECK_EQ(sell.filled_quantity, Quantity(10));
+    CHECK_EQ(trades.back().price, Price(9800));
+    CHECK_EQ(sell_book.get_best_bid(), Price(9700));
+
+    // A band of zero takes the best level only
+    OrderBook tight;
+    seed_levels(tight, Side::BUY, 10000, 100);
+    trades.clear();
+    CHECK_EQ(tight.add_market_order(15, Side::BUY, 0, TradeCollector{&trades}).filled_quantity, Quantity(5));
+
+    // A band wider than the prices go saturates instead of wrapping
+    OrderBook wide(100);
+    seed_levels(wide, Side::BUY, 10000, 100);
+    seed_levels(wide, Side::SELL, 9900, 100);
+    trades.clear();
+    CHECK_EQ(wide.add_market_order(15, Side::BUY, OrderBook::kUnprotected - 1, TradeCollector{&trades}).filled_quantity,
+             Quantity(15));
+    CHECK_EQ(wide.add_market_order(15, Side::SELL, OrderBook::kUnprotected - 1, TradeCollector{&trades}).filled_quantity,
+             Quantity(15));
+}
+
+TEST(market_orders_over_http) {
+    test::LoopbackEngine engine;
+    std::string body;
+    REQUIRE(engine.request("POST", "/order", R"({"price":100.00,"quantity":5,"side":"SELL"})", body) == 200);
+    REQUIRE(engine.request("POST", "/order", R"({"price":101.00,"quantity":5,"side":"SELL"})", body) == 200);
+
+    // No price needed, and none echoed
+    REQUIRE(engine.request("POST", "/order", R"({"type":"MARKET","quantity":2,"side":"BUY"})", body) == 200);
+    json plain = json::parse(body);
+    CHECK_EQ(plain["type"].get<std::string>(), "MARKET");
+    CHECK_EQ(plain["time_in_force"].get<std::string>(), "IOC");
+    CHECK_EQ(plain["filled_quantity"].get<int>(), 2);
+    CHECK(!plain.contains("price_internal"));
+    CHECK(!plain.contains("protection_ticks"));
+
+    // The band is echoed, and stops the sweep at 100.00
+    REQUIRE(engine.request("POST", "/order", R"({"type":"MARKET","quantity":8,"side":"BUY","protection_ticks":50})", body) == 200);
+    json banded = json::parse(body);
+    CHECK_EQ(banded["protection_ticks"].get<int>(), 50);
+    CHECK_EQ(banded["filled_quantity"].get<int>(), 3);
+    CHECK_EQ(banded["order_status"].get<std::string>(), "CANCELLED");
+    CHECK_EQ(banded["resting_quantity"].get<int>(), 0);
+    CHECK_EQ(banded["order_count"].get<int>(), 1);
+
+    // Refused on a limit order, and when negative
+    CHECK_EQ(engine.request("POST", "/order", R"({"price":101.00,"quantity":1,"side":"BUY","protection_ticks":5})", body), 400);
+    CHECK_EQ(json::parse(body)["error"].get<std::string>(), "protection_ticks only applies to MARKET orders");
+    CHECK_EQ(engine.request("POST", "/order", R"({"type":"MARKET","quantity":1,"side":"BUY","protection_ticks":-1})", body), 400);
+    CHECK_EQ(engine.gateway().market_data(0).order_count, size_t(1));
+}
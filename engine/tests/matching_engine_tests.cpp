@@ -0,0 +1,143 @@
+#include <string>
+#include <vector>
+#include "test.hpp"
+#include "loopback.hpp"
+#include "../include/symbol_directory.hpp"
+#include "../include/binary_client.hpp"
+#include "../include/nlohmann/json.hpp"
+
+using namespace trading;
+using json = nlohmann::json;
+
+TEST(symbol_directory_interns_names) {
+    SymbolDirectory symbols;
+    CHECK_EQ(symbols.add("AAPL"), SymbolId(0));
+    CHECK_EQ(symbols.add("MSFT"), SymbolId(1));
+    CHECK_EQ(symbols.add("AAPL"), SymbolId(0));
+    CHECK_EQ(symbols.size(), size_t(2));
+    CHECK_EQ(symbols.add(""), SymbolDirectory::kNoSymbol);
+    CHECK_EQ(symbols.add("SEVENTEEN_LETTERS"), SymbolDirectory::kNoSymbol);
+
+    // Lookups stay valid as names are added after them
+    for (int i = 0; i < 100; ++i) {
+        symbols.add("S" + std::to_string(i));
+    }
+    CHECK_EQ(symbols.find("MSFT"), SymbolId(1));
+    CHECK_EQ(symbols.find("S99"), SymbolId(101));
+    CHECK_EQ(symbols.find("NOPE"), SymbolDirectory::kNoSymbol);
+    CHECK_EQ(symbols.name(1), std::string("MSFT"));
+}
+
+TEST(global_order_ids_carry_the_symbol) {
+    OrderId id = SymbolDirectory::to_global(3, 42);
+    CHECK_EQ(SymbolDirectory::symbol_of(id), SymbolId(3));
+    CHECK_EQ(SymbolDirectory::local_id(id), OrderId(42));
+    CHECK_EQ(SymbolDirectory::to_global(0, 42), OrderId(42));
+    CHECK_EQ(SymbolDirectory::to_global(3, 0), OrderId(0));
+}
+
+TEST(engine_routes_by_global_order_id) {
+    // Two shards, so symbols 0 and 1 are matched on different threads
+    test::LoopbackEngine engine({"AAPL", "MSFT", "GOOG"}, 2);
+    MatchingEngine::Gateway& gateway = engine.gateway();
+    CHECK_EQ(gateway.shard_count(), size_t(2));
+    CHECK(gateway.shard_of(0) != gateway.shard_of(1));
+
+    // The first order on each book has local ID 1
+    OrderResult aapl = gateway.add_order(0, 10000, 5, Side::SELL, TimeInForce::GTC);
+    OrderResult msft = gateway.add_order(1, 10000, 5, Side::SELL, TimeInForce::GTC);
+    CHECK_EQ(aapl.order_id, OrderId(1));
+    CHECK_EQ(msft.order_id, SymbolDirectory::to_global(1, 1));
+
+    // Cancelling MSFT's order leaves AAPL's, though both are local ID 1
+    CHECK(gateway.cancel_order(msft.order_id));
+    CHECK_EQ(gateway.order_count(), size_t(0));
+    CHECK(!gateway.cancel_order(msft.order_id));
+    CHECK_EQ(gateway.market_data(0).order_count, size_t(1));
+
+    // Amends route the same way, and trades name both sides globally
+    OrderResult goog = gateway.add_order(2, 9900, 5, Side::BUY, TimeInForce::GTC);
+    gateway.add_order(2, 10000, 2, Side::SELL, TimeInForce::GTC);
+    CHECK(gateway.amend_order(goog.order_id, 10000, 5));
+    REQUIRE(gateway.trades().size() == 1);
+    CHECK_EQ(gateway.trades()[0].buyer_id, goog.order_id);
+    CHECK_EQ(SymbolDirectory::symbol_of(gateway.trades()[0].seller_id), SymbolId(2));
+    CHECK_EQ(gateway.market_data(0).order_count, size_t(1));
+
+    // An ID naming no symbol goes nowhere
+    CHECK(!gateway.cancel_order(SymbolDirectory::to_global(7, 1)));
+    CHECK(!gateway.amend_order(SymbolDirectory::to_global(7, 1), 10000, 1));
+}
+
+TEST(http_routes_by_symbol_and_order_id) {
+    test::LoopbackEngine engine({"AAPL", "MSFT"}, 2);
+    std::string body;
+    REQUIRE(engine.request("POST", "/order", R"({"price":100,"quantity":5,"side":"SELL","symbol":"MSFT"})", body) == 200);
+    OrderId msft = json::parse(body)["order_id"].get<OrderId>();
+    CHECK_EQ(SymbolDirectory::symbol_of(msft), SymbolId(1));
+
+    CHECK_EQ(engine.request("POST", "/order", R"({"price":100,"quantity":5,"side":"SELL","symbol":"NOPE"})", body), 400);
+
+    // A batch over both books reports each book's count
+    REQUIRE(engine.request("POST", "/orders", R"([
+        {"price":99,"quantity":1,"side":"BUY"},
+        {"price":99,"quantity":1,"side":"BUY","symbol":"MSFT"},
+        {"price":98,"quantity":1,"side":"BUY","symbol":1}
+    ])", body) == 200);
+    json batch = json::parse(body);
+    CHECK(!batch.contains("order_count"));
+    REQUIRE(batch["order_counts"].size() == 2);
+    CHECK_EQ(batch["order_counts"][0]["symbol"].get<std::string>(), "AAPL");
+    CHECK_EQ(batch["order_counts"][0]["order_count"].get<int>(), 1);
+    CHECK_EQ(batch["order_counts"][1]["symbol"].get<std::string>(), "MSFT");
+    CHECK_EQ(batch["order_counts"][1]["order_count"].get<int>(), 3);
+
+    // With nothing valid, the default symbol's count
+    REQUIRE(engine.request("POST", "/orders", R"([{"price":99,"quantity":0,"side":"BUY"}])", body) == 200);
+    CHECK_EQ(json::parse(body)["order_count"].get<int>(), 1);
+
+    std::string cancel = "{\"order_id\":" + std::to_string(msft) + "}";
+    CHECK_EQ(engine.request("DELETE", "/order", cancel, body), 200);
+    CHECK_EQ(engine.request("DELETE", "/order", cancel, body), 404);
+    CHECK_EQ(engine.gateway().market_data(1).order_count, size_t(2));
+}
+
+TEST(journal_failure_halts_input) {
+    // Every write to /dev/full fails, so the first input's journal flush does
+    test::LoopbackEngine engine({"AAPL"}, 1, "/dev/full");
+    REQUIRE(engine.journaling());
+    MatchingEngine::Gateway& gateway = engine.gateway();
+
+    CHECK_THROWS_AS(gateway.add_order(0, 10000, 5, Side::SELL, TimeInForce::GTC), EngineHalted);
+    CHECK_THROWS_AS(gateway.add_order(0, 9900, 5, Side::BUY, TimeInForce::GTC), EngineHalted);
+    CHECK_THROWS_AS(gateway.cancel_order(1), EngineHalted);
+    CHECK_THROWS_AS(gateway.amend_order(1, 10000, 1), EngineHalted);
+
+    std::string body;
+    CHECK_EQ(engine.request("POST", "/order", R"({"price":100,"quantity":5,"side":"SELL"})", body), 503);
+    CHECK_EQ(json::parse(body)["error"].get<std::string>(), "Engine halted: input journal failed");
+    // A batch fails the entries for halted shards one by one
+    REQUIRE(engine.request("POST", "/orders", R"([{"price":100,"quantity":5,"side":"SELL"}])", body) == 200);
+    json batch = json::parse(body);
+    CHECK_EQ(batch["accepted"].get<int>(), 0);
+    CHECK_EQ(batch["results"][0]["error"]["error"].get<std::string>(), "Engine halted: input journal failed");
+    CHECK_EQ(engine.request("DELETE", "/order", R"({"order_id":1})", body), 503);
+
+    BinaryClient client;
+    REQUIRE(client.connect("127.0.0.1", engine.binary_port()));
+    wire::ExecutionReport report;
+    std::vector<wire::Fill> fills;
+    REQUIRE(client.new_order(0, BinaryClient::limit(10000, 5, Side::SELL), report, fills));
+    CHECK_EQ(report.reason, wire::RejectReason::ENGINE_HALTED);
+
+    // Queries still answer, and nothing reached the book
+    REQUIRE(engine.request("GET", "/orderbook", "", body) == 200);
+    json book = json::parse(body);
+    CHECK_EQ(book["order_count"].get<int>(), 0);
+    CHECK_EQ(book["bid_levels"].get<int>(), 0);
+    CHECK_EQ(book["ask_levels"].get<int>(), 0);
+    MarketData data = gateway.market_data(0);
+    CHECK_EQ(data.order_count, size_t(0));
+    CHECK_EQ(data.traded_volume, uint64_t(0));
+    CHECK_EQ(gateway.order_count(), size_t(0));
+}
@@ -0,0 +1,117 @@
+#include <vector>
+#include <algorithm>
+#include "test.hpp"
+#include "../include/occupancy_bitmap.hpp"
+
+using namespace trading;
+
+namespace {
+
+size_t naive_next(const std::vector<bool>& bits, size_t i) {
+    for (; i < bits.size(); ++i) {
+        if (bits[i]) return i;
+    }
+    return OccupancyBitmap::npos;
+}
+
+size_t naive_prev(const std::vector<bool>& bits, size_t i) {
+    if (bits.empty()) return OccupancyBitmap::npos;
+    i = std::min(i, bits.size() - 1);
+    for (;;) {
+        if (bits[i]) return i;
+        if (i == 0) return OccupancyBitmap::npos;
+        --i;
+    }
+}
+
+// Indices either side of every word and summary-word boundary in the bitmap
+std::vector<size_t> boundaries(size_t size) {
+    std::vector<size_t> at = {0, 1};
+    for (size_t span : {size_t(64), size_t(64 * 64), size_t(64 * 64 * 64)}) {
+        for (size_t edge = span; edge <= size; edge += span) {
+            at.push_back(edge - 1);
+            at.push_back(edge);
+            if (edge / span > 3) break;
+        }
+    }
+    at.push_back(size - 1);
+    at.erase(std::remove_if(at.begin(), at.end(), [size](size_t i) { return i >= size; }), at.end());
+    return at;
+}
+
+void check_against_naive(const OccupancyBitmap& bitmap, const std::vector<bool>& bits) {
+    for (size_t i : boundaries(bits.size())) {
+        CHECK_EQ(bitmap.find_next(i), naive_next(bits, i));
+        CHECK_EQ(bitmap.find_prev(i), naive_prev(bits, i));
+        CHECK_EQ(bitmap.test(i), bool(bits[i]));
+    }
+    CHECK_EQ(bitmap.first(), naive_next(bits, 0));
+    CHECK_EQ(bitmap.last(), naive_prev(bits, bits.size()));
+    CHECK_EQ(bitmap.none(), std::find(bits.begin(), bits.end(), true) == bits.end());
+}
+
+}
+
+TEST(occupancy_bitmap_empty) {
+    OccupancyBitmap bitmap(4096);
+    CHECK(bitmap.none());
+    CHECK_EQ(bitmap.find_next(0), OccupancyBitmap::npos);
+    CHECK_EQ(bitmap.find_prev(4095), OccupancyBitmap::npos);
+    CHECK_EQ(bitmap.find_next(5000), OccupancyBitmap::npos);
+
+    OccupancyBitmap nothing;
+    CHECK_EQ(nothing.first(), OccupancyBitmap::npos);
+    CHECK_EQ(nothing.last(), OccupancyBitmap::npos);
+}
+
+TEST(occupancy_bitmap_single_bit_at_boundaries) {
+    for (size_t size : {size_t(1), size_t(64), size_t(65), size_t(4096), size_t(4097), size_t(64 * 64 * 64 + 1)}) {
+        for (size_t bit : boundaries(size)) {
+            OccupancyBitmap bitmap(size);
+            std::vector<bool> bits(size);
+            bitmap.set(bit);
+            bits[bit] = true;
+            check_against_naive(bitmap, bits);
+
+            bitmap.clear(bit);
+            bits[bit] = false;
+            check_against_naive(bitmap, bits);
+        }
+    }
+}
+
+TEST(occupancy_bitmap_searches_across_empty_words) {
+    // Bits far apart, so each search has to climb to a summary level and
+    // come back down
+    size_t size = 64 * 64 * 64 + 1;
+    OccupancyBitmap bitmap(size);
+    std::vector<bool> bits(size);
+    for (size_t bit : {size_t(5), size_t(64 * 64 - 1), size_t(64 * 64 * 2), size_t(size - 1)}) {
+        bitmap.set(bit);
+        bits[bit] = true;
+    }
+    check_against_naive(bitmap, bits);
+    CHECK_EQ(bitmap.find_next(6), size_t(64 * 64 - 1));
+    CHECK_EQ(bitmap.find_next(64 * 64), size_t(64 * 64 * 2));
+    CHECK_EQ(bitmap.find_prev(64 * 64 * 2 - 1), size_t(64 * 64 - 1));
+    CHECK_EQ(bitmap.find_prev(size - 2), size_t(64 * 64 * 2));
+
+    // Clearing one of two bits in a word must leave the summary bit set
+    bitmap.set(64 * 64 * 2 + 1);
+    bits[64 * 64 * 2 + 1] = true;
+    bitmap.clear(64 * 64 * 2);
+    bits[64 * 64 * 2] = false;
+    check_against_naive(bitmap, bits);
+    CHECK_EQ(bitmap.find_next(64 * 64), size_t(64 * 64 * 2 + 1));
+}
+
+TEST(occupancy_bitmap_reset_clears) {
+    OccupancyBitmap bitmap(128);
+    bitmap.set(127);
+    bitmap.reset(4097);
+    CHECK_EQ(bitmap.size(), size_t(4097));
+    CHECK(bitmap.none());
+    bitmap.set(4096);
+    CHECK_EQ(bitmap.last(), size_t(4096));
+    CHECK_EQ(bitmap.find_prev(4095), OccupancyBitmap::npos);
+}
@@ -0,0 +1,102 @@
+#include <string>
+#include <vector>
+#include "test.hpp"
+#include "loopback.hpp"
+#include "../include/order_decoder.hpp"
+#include "../include/nlohmann/json.hpp"
+
+using namespace trading;
+using json = nlohmann::json;
+
+namespace {
+
+Price cents_of(std::string_view text) {
+    Price cents = -1;
+    return decimal_to_cents(text, cents) ? cents : -1;
+}
+
+// POST /order body with `price` written as given. Spelling the key with an
+// escape makes the fast decoder turn it down, so the DOM path handles it.
+std::string order_body(const std::string& price, const std::string& rest, bool escaped) {
+    return std::string("{") + (escaped ? "\"\\u0070rice\":" : "\"price\":") + price + "," + rest + "}";
+}
+
+}
+
+TEST(decimal_to_cents_is_exact) {
+    CHECK_EQ(cents_of("100"), Price(10000));
+    CHECK_EQ(cents_of("100.5"), Price(10050));
+    CHECK_EQ(cents_of("0.01"), Price(1));
+    CHECK_EQ(cents_of("1.005"), Price(101));     // Half up on the third decimal
+    CHECK_EQ(cents_of("1.0049999"), Price(100));
+    CHECK_EQ(cents_of("0.015"), Price(2));
+    CHECK_EQ(cents_of("99.995"), Price(10000));
+    CHECK_EQ(cents_of("1e2"), Price(10000));
+    CHECK_EQ(cents_of("2.5E-2"), Price(3));
+    CHECK_EQ(cents_of("12345.675"), Price(1234568));
+    CHECK_EQ(cents_of(""), Price(-1));
+    CHECK_EQ(cents_of("abc"), Price(-1));
+    CHECK_EQ(cents_of("1.2.3"), Price(-1));
+}
+
+TEST(decoder_accepts_plain_bodies_only) {
+    OrderRequest req{};
+    double price = 0;
+    SymbolField symbol;
+    CHECK(decode_order_request(R"({"price":100.25,"quantity":7,"side":"SELL","time_in_force":"IOC"})", req, price, symbol));
+    CHECK_EQ(req.price, Price(10025));
+    CHECK_EQ(req.quantity, Quantity(7));
+    CHECK_EQ(req.side, Side::SELL);
+    CHECK_EQ(req.tif, TimeInForce::IOC);
+    CHECK_EQ(symbol.kind, SymbolField::NONE);
+
+    CHECK(decode_order_request(R"({"price":1,"quantity":1,"side":"BUY","symbol":"MSFT"})", req, price, symbol));
+    CHECK_EQ(symbol.kind, SymbolField::NAME);
+    CHECK_EQ(std::string(symbol.name), std::string("MSFT"));
+
+    // Left to the DOM path
+    CHECK(!decode_order_request(R"({"\u0070rice":1,"quantity":1,"side":"BUY"})", req, price, symbol));
+    CHECK(!decode_order_request(R"({"price":1,"price":2,"quantity":1,"side":"BUY"})", req, price, symbol));
+    CHECK(!decode_order_request(R"({"price":1,"quantity":0,"side":"BUY"})", req, price, symbol));
+    CHECK(!decode_order_request(R"({"type":"MARKET","quantity":1,"side":"BUY","time_in_force":"FOK"})", req, price, symbol));
+
+    OrderId id = 0;
+    CHECK(decode_cancel_request(R"({"order_id":42})", id));
+    CHECK_EQ(id, OrderId(42));
+    CHECK(!decode_cancel_request(R"({"order_id":-1})", id));
+}
+
+TEST(decoder_and_dom_answer_alike) {
+    test::LoopbackEngine engine;
+    // IOC against an empty book, so both requests of a pair meet the same
+    // book and differ only in the order ID they are given
+    std::vector<std::string> prices = {"100", "100.5", "1.005", "0.015", "99.995", "12345.675", "1e2", "2.5e-2",
+                                       "0.001", "0", "-5", "1000000.01", "\"12\""};
+    for (const std::string& price : prices) {
+        std::string fast_body;
+        std::string dom_body;
+        int fast = engine.request("POST", "/order", order_body(price, R"("quantity":3,"side":"BUY","time_in_force":"IOC")", false), fast_body);
+        int dom = engine.request("POST", "/order", order_body(price, R"("quantity":3,"side":"BUY","time_in_force":"IOC")", true), dom_body);
+        CHECK_EQ(fast, dom);
+
+        json fast_json = json::parse(fast_body);
+        json dom_json = json::parse(dom_body);
+        fast_json.erase("order_id");
+        dom_json.erase("order_id");
+        if (fast_json != dom_json) {
+            test::fail(__FILE__, __LINE__, "price " + price + ": " + fast_json.dump() + " vs " + dom_json.dump());
+        }
+    }
+
+    // And for bodies that are invalid in other ways
+    for (const std::string& rest : {std::string(R"("quantity":0,"side":"BUY")"), std::string(R"("quantity":1,"side":"HOLD")"),
+                                    std::string(R"("quantity":1,"side":"BUY","time_in_force":"DAY")")}) {
+        std::string fast_body;
+        std::string dom_body;
+        int fast = engine.request("POST", "/order", order_body("10", rest, false), fast_body);
+        int dom = engine.request("POST", "/order", order_body("10", rest, true), dom_body);
+        CHECK_EQ(fast, 400);
+        CHECK_EQ(dom, 400);
+        CHECK_EQ(fast_body, dom_body);
+    }
+}
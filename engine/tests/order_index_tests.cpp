@@ -0,0 +1,101 @@
+#include <vector>
+#include "test.hpp"
+#include "../include/order_index.hpp"
+
+using namespace trading;
+
+namespace {
+
+// Orders are only stored and compared, never dereferenced
+std::vector<Order> make_orders(size_t count) {
+    std::vector<Order> orders;
+    orders.reserve(count + 1);
+    for (size_t id = 0; id <= count; ++id) {
+        orders.emplace_back(id, 1, Side::BUY);
+    }
+    return orders;
+}
+
+constexpr OrderId kPage = OrderIndex::kPageSize;
+
+}
+
+TEST(order_index_grows_across_pages) {
+    std::vector<Order> orders = make_orders(3 * kPage + 5);
+    OrderIndex index;
+    CHECK(index.find(1) == nullptr);
+
+    for (OrderId id = 1; id < orders.size(); ++id) {
+        index.insert(id, &orders[id]);
+    }
+    CHECK_EQ(index.size(), orders.size() - 1);
+    for (OrderId id : {OrderId(1), kPage - 1, kPage, kPage + 1, 3 * kPage, OrderId(orders.size() - 1)}) {
+        CHECK(index.find(id) == &orders[id]);
+    }
+    CHECK(index.find(orders.size()) == nullptr);
+    CHECK(index.find(100 * kPage) == nullptr);
+
+    // Re-inserting a live ID replaces it without counting twice
+    index.insert(7, &orders[8]);
+    CHECK_EQ(index.size(), orders.size() - 1);
+    CHECK(index.find(7) == &orders[8]);
+}
+
+TEST(order_index_erase) {
+    std::vector<Order> orders = make_orders(10);
+    OrderIndex index;
+    for (OrderId id = 1; id <= 10; ++id) {
+        index.insert(id, &orders[id]);
+    }
+    CHECK(index.erase(4));
+    CHECK(!index.erase(4));
+    CHECK(!index.erase(11));
+    CHECK(!index.erase(50 * kPage));
+    CHECK(index.find(4) == nullptr);
+    CHECK(index.find(5) == &orders[5]);
+    CHECK_EQ(index.size(), size_t(9));
+}
+
+TEST(order_index_keeps_a_partly_issued_page) {
+    std::vector<Order> orders = make_orders(20);
+    OrderIndex index;
+    for (OrderId id = 1; id <= 10; ++id) {
+        index.insert(id, &orders[id]);
+    }
+    for (OrderId id = 1; id <= 10; ++id) {
+        CHECK(index.erase(id));
+    }
+    CHECK_EQ(index.size(), size_t(0));
+
+    // The page still has IDs to come, so it stays mapped
+    index.insert(11, &orders[11]);
+    CHECK(index.find(11) == &orders[11]);
+    CHECK(index.find(10) == nullptr);
+    CHECK_EQ(index.size(), size_t(1));
+}
+
+TEST(order_index_recycles_a_retired_page_clean) {
+    std::vector<Order> orders = make_orders(3 * kPage);
+    OrderIndex index;
+    for (OrderId id = 1; id < 2 * kPage; ++id) {
+        index.insert(id, &orders[id]);
+    }
+    // Page 0 is fully issued; emptying it retires it
+    for (OrderId id = 1; id < kPage; ++id) {
+        CHECK(index.erase(id));
+    }
+    CHECK(index.find(1) == nullptr);
+    CHECK(index.find(kPage - 1) == nullptr);
+    CHECK_EQ(index.size(), size_t(kPage));
+
+    // The next page mapped reuses it and must not see its old entries
+    index.insert(2 * kPage + 3, &orders[2 * kPage + 3]);
+    CHECK(index.find(2 * kPage + 3) == &orders[2 * kPage + 3]);
+    size_t stale = 0;
+    for (OrderId id = 2 * kPage; id < 3 * kPage; ++id) {
+        if (id != 2 * kPage + 3 && index.find(id) != nullptr) ++stale;
+    }
+    CHECK_EQ(stale, size_t(0));
+    CHECK(index.find(kPage) == &orders[kPage]);
+    CHECK_EQ(index.size(), size_t(kPage + 1));
+}
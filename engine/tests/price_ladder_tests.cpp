@@ -0,0 +1,110 @@
+#include <vector>
+#include "test.hpp"
+#include "../include/price_ladder.hpp"
+
+using namespace trading;
+
+namespace {
+
+template<Side S>
+std::vector<Price> prices_descending(const PriceLadder<S>& ladder) {
+    std::vector<Price> prices;
+    ladder.for_each_descending([&prices](const PriceLevel& level) { prices.push_back(level.get_price()); });
+    return prices;
+}
+
+}
+
+TEST(price_ladder_tracks_best_level) {
+    OrderPool pool;
+    PriceLadder<Side::BUY> bids;
+    Order* low = pool.acquire(1, 9900, 5, Side::BUY);
+    Order* high = pool.acquire(2, 10100, 5, Side::BUY);
+    bids.add_order(low, 9900);
+    bids.add_order(high, 10100);
+    CHECK_EQ(bids.best_price(), Price(10100));
+    CHECK_EQ(bids.level_count(), size_t(2));
+
+    bids.remove_order(high);
+    CHECK_EQ(bids.best_price(), Price(9900));
+    bids.remove_order(low);
+    CHECK(bids.empty());
+    CHECK_EQ(bids.best_price(), Price(0));
+}
+
+TEST(price_ladder_recentres_when_empty) {
+    OrderPool pool;
+    PriceLadder<Side::SELL> asks(1, 4096);
+    Order* first = pool.acquire(1, 10000, 5, Side::SELL);
+    asks.add_order(first, 10000);
+    asks.remove_order(first);
+
+    // Far outside the old window: an empty ladder just moves
+    CHECK(asks.can_hold(5000000));
+    Order* far = pool.acquire(2, 5000000, 5, Side::SELL);
+    asks.add_order(far, 5000000);
+    CHECK_EQ(asks.best_price(), Price(5000000));
+    CHECK_EQ(asks.level_count(), size_t(1));
+    CHECK(OrderPool::info(far).level == asks.find(5000000));
+    CHECK(asks.find(10000) == nullptr);
+}
+
+TEST(price_ladder_regrows_around_populated_levels) {
+    OrderPool pool;
+    PriceLadder<Side::BUY> bids(1, 4096);
+    std::vector<Order*> orders;
+    Price prices[] = {10000, 10001, 12000, 8100};
+    for (Price price : prices) {
+        orders.push_back(pool.acquire(orders.size() + 1, price, 1, Side::BUY));
+        bids.add_order(orders.back(), price);
+    }
+
+    // 8100..12000 spans well past the initial window, so it has regrown with
+    // every order re-pointed at its moved level
+    CHECK_EQ(bids.level_count(), size_t(4));
+    CHECK_EQ(bids.best_price(), Price(12000));
+    CHECK(prices_descending(bids) == (std::vector<Price>{12000, 10001, 10000, 8100}));
+    for (size_t i = 0; i < orders.size(); ++i) {
+        REQUIRE(OrderPool::info(orders[i]).level != nullptr);
+        CHECK_EQ(OrderPool::info(orders[i]).level->get_price(), prices[i]);
+        CHECK(OrderPool::info(orders[i]).level == bids.find(prices[i]));
+    }
+
+    bids.remove_order(orders[2]);
+    CHECK_EQ(bids.best_price(), Price(10001));
+    bids.remove_order(orders[1]);
+    bids.remove_order(orders[0]);
+    CHECK_EQ(bids.best_price(), Price(8100));
+}
+
+TEST(price_ladder_caps_the_window) {
+    OrderPool pool;
+    PriceLadder<Side::SELL> asks(1, 4096);
+    Order* order = pool.acquire(1, 10000, 1, Side::SELL);
+    asks.add_order(order, 10000);
+
+    CHECK(asks.can_hold(10000 + 4095));
+    CHECK(!asks.can_hold(10000 + 4096));
+    CHECK(asks.can_hold(10000 - 4095));
+    CHECK(!asks.can_hold(10000 - 4096));
+
+    Order* edge = pool.acquire(2, 10000 + 4095, 1, Side::SELL);
+    asks.add_order(edge, 10000 + 4095);
+    CHECK_EQ(asks.best_price(), Price(10000));
+    CHECK(!asks.can_hold(9999));
+
+    // Once the low end leaves, the window may extend the other way
+    asks.remove_order(order);
+    CHECK(asks.can_hold(10000 + 4095 + 4095));
+}
+
+TEST(price_ladder_respects_tick_grid) {
+    PriceLadder<Side::BUY> bids(5);
+    CHECK(bids.on_grid(10005));
+    CHECK(!bids.on_grid(10003));
+    CHECK(bids.can_hold(10005));
+    CHECK(!bids.can_hold(10003));
+
+    PriceLadder<Side::BUY> no_tick(0);
+    CHECK(!no_tick.can_hold(10000));
+}
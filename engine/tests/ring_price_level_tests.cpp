@@ -0,0 +1,114 @@
+#include <vector>
+#include "test.hpp"
+#include "../include/ring_price_level.hpp"
+
+using namespace trading;
+
+namespace {
+
+std::vector<Order*> rest_orders(RingPriceLevel& level, OrderPool& pool, size_t count) {
+    std::vector<Order*> orders;
+    for (size_t i = 0; i < count; ++i) {
+        Order* order = pool.acquire(i + 1, 10000, static_cast<Quantity>(i + 1), Side::BUY);
+        level.add_order(order, pool);
+        orders.push_back(order);
+    }
+    return orders;
+}
+
+}
+
+TEST(order_pool_handles_round_trip) {
+    // One past a full slab, so handles span two slabs
+    OrderPool pool;
+    std::vector<Order*> orders;
+    for (size_t i = 0; i < OrderPool::kOrdersPerSlab + 3; ++i) {
+        orders.push_back(pool.acquire(i + 1, 10000, 1, Side::SELL));
+    }
+    CHECK_EQ(pool.stats().slab_count, size_t(2));
+    for (Order* order : {orders.front(), orders[OrderPool::kOrdersPerSlab - 1], orders.back()}) {
+        CHECK(pool.at(pool.handle_of(order)) == order);
+    }
+    CHECK_EQ(pool.handle_of(orders[OrderPool::kOrdersPerSlab]), OrderHandle(OrderPool::kOrdersPerSlab));
+}
+
+TEST(ring_level_keeps_arrival_order_across_growth) {
+    OrderPool pool;
+    RingPriceLevel level(10000);
+    CHECK(level.get_head(pool) == nullptr);
+
+    // Past the initial capacity, wrapping before the ring grows
+    std::vector<Order*> orders = rest_orders(level, pool, 5);
+    for (size_t i = 0; i < 3; ++i) {
+        REQUIRE(level.get_head(pool) == orders[i]);
+        level.update_quantity(orders[i]->remaining_quantity());
+        level.pop_head();
+        pool.release(orders[i]);
+    }
+    std::vector<Order*> more = rest_orders(level, pool, RingPriceLevel::kInitialCapacity + 4);
+    CHECK_EQ(level.order_count(), more.size() + 2);
+
+    CHECK(level.get_head(pool) == orders[3]);
+    level.pop_head();
+    CHECK(level.get_head(pool) == orders[4]);
+    level.pop_head();
+    for (Order* order : more) {
+        REQUIRE(level.get_head(pool) == order);
+        level.pop_head();
+    }
+    CHECK(level.get_head(pool) == nullptr);
+}
+
+TEST(ring_level_tombstones_and_compaction) {
+    OrderPool pool;
+    RingPriceLevel level(10000);
+    std::vector<Order*> orders = rest_orders(level, pool, RingPriceLevel::kMinCompactSize + 1);
+    Quantity total = level.get_total_quantity();
+
+    // Cancelling the head leaves a tombstone that get_head releases
+    level.cancel_order(orders[0], pool);
+    total -= 1;
+    CHECK_EQ(level.get_total_quantity(), total);
+    CHECK_EQ(level.order_count(), orders.size() - 1);
+    CHECK_EQ(pool.stats().in_use, orders.size());
+    CHECK(level.get_head(pool) == orders[1]);
+    CHECK_EQ(pool.stats().in_use, orders.size() - 1);
+
+    // 32 tombstones out of 64 entries is only half
+    for (size_t i = 2; i < orders.size(); i += 2) {
+        level.cancel_order(orders[i], pool);
+    }
+    CHECK_EQ(pool.stats().in_use, orders.size() - 1);
+
+    // The 33rd passes half, and compaction releases them all
+    level.cancel_order(orders[1], pool);
+    size_t live = level.order_count();
+    CHECK_EQ(live, size_t(31));
+    CHECK_EQ(pool.stats().in_use, live);
+
+    // Survivors keep their order
+    Order* previous = nullptr;
+    while (Order* head = level.get_head(pool)) {
+        CHECK(previous == nullptr || head->id > previous->id);
+        previous = head;
+        level.update_quantity(head->remaining_quantity());
+        level.pop_head();
+        pool.release(head);
+        --live;
+    }
+    CHECK_EQ(live, size_t(0));
+    CHECK_EQ(level.get_total_quantity(), Quantity(0));
+    CHECK_EQ(pool.stats().in_use, size_t(0));
+}
+
+TEST(ring_level_of_only_tombstones_empties) {
+    OrderPool pool;
+    RingPriceLevel level(10000);
+    std::vector<Order*> orders = rest_orders(level, pool, 3);
+    for (Order* order : orders) {
+        level.cancel_order(order, pool);
+    }
+    CHECK(level.is_empty());
+    CHECK_EQ(pool.stats().in_use, size_t(0));
+    CHECK(level.get_head(pool) == nullptr);
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <string>
+#include <sstream>
+#include <vector>
+#include <type_traits>
+
+namespace trading {
+namespace test {
+
+// Minimal self-registering test runner. TEST(name) defines a case; CHECK,
+// CHECK_EQ and CHECK_THROWS_AS record a failure and let the case carry on,
+// REQUIRE stops it. lob_tests runs every case, or those whose name contains
+// its argument, and exits non-zero if any check failed.
+
+struct TestCase {
+    const char* name;
+    void (*run)();
+};
+
+std::vector<TestCase>& registry();
+void fail(const char* file, int line, const std::string& what);
+
+struct Registrar {
+    Registrar(const char* name, void (*run)()) { registry().push_back(TestCase{name, run}); }
+};
+
+// Thrown by REQUIRE to abandon the current case
+struct Abort {};
+
+template<typename T>
+std::string describe(const T& value) {
+    std::ostringstream out;
+    if constexpr (std::is_enum<T>::value) {
+        out << static_cast<long long>(value);
+    } else if constexpr (std::is_same<T, bool>::value) {
+        out << (value ? "true" : "false");
+    } else if constexpr (std::is_convertible<T, std::string>::value) {
+        out << '"' << std::string(value) << '"';
+    } else if constexpr (std::is_integral<T>::value && sizeof(T) == 1) {
+        out << static_cast<int>(value);
+    } else {
+        out << value;
+    }
+    return out.str();
+}
+
+template<typename A, typename B>
+void check_eq(const A& actual, const B& expected, const char* expr_a, const char* expr_b, const char* file, int line) {
+    if (actual == expected) return;
+    fail(file, line, std::string(expr_a) + " == " + expr_b + " (" + describe(actual) + " vs " + describe(expected) + ")");
+}
+
+}
+}
+
+#define TEST(name) \
+    static void name(); \
+    static ::trading::test::Registrar name##_registrar(#name, name); \
+    static void name()
+
+#define CHECK(cond) \
+    do { if (!(cond)) ::trading::test::fail(__FILE__, __LINE__, #cond); } while (0)
+
+#define CHECK_EQ(actual, expected) \
+    ::trading::test::check_eq((actual), (expected), #actual, #expected, __FILE__, __LINE__)
+
+#define REQUIRE(cond) \
+    do { if (!(cond)) { ::trading::test::fail(__FILE__, __LINE__, #cond); throw ::trading::test::Abort{}; } } while (0)
+
+#define CHECK_THROWS_AS(expr, type) \
+    do { \
+        bool threw = false; \
+        try { (void)(expr); } catch (const type&) { threw = true; } \
+        if (!threw) ::trading::test::fail(__FILE__, __LINE__, #expr " throws " #type); \
+    } while (0)
@@ -0,0 +1,101 @@
+#include <vector>
+#include <stdexcept>
+#include "test.hpp"
+#include "../include/order_book.hpp"
+
+using namespace trading;
+
+namespace {
+
+struct TradeCollector {
+    std::vector<Trade>* trades;
+    void operator()(const Trade& trade) const { trades->push_back(trade); }
+};
+
+// Asks of 5 at 10000, 10100 and 10200: orders 1 to 3
+void seed_asks(OrderBook& book) {
+    book.add_order(10000, 5, Side::SELL);
+    book.add_order(10100, 5, Side::SELL);
+    book.add_order(10200, 5, Side::SELL);
+}
+
+}
+
+TEST(fok_that_cannot_fill_has_no_side_effects) {
+    OrderBook book;
+    seed_asks(book);
+    std::vector<Trade> trades;
+
+    // Enough shares exist, but not at or below the limit
+    OrderResult result = book.add_order(10100, 11, Side::BUY, TimeInForce::FOK, TradeCollector{&trades});
+    CHECK_EQ(result.status, OrderStatus::REJECTED);
+    CHECK_EQ(result.order_id, OrderId(0));
+    CHECK_EQ(result.filled_quantity, Quantity(0));
+    CHECK(trades.empty());
+    CHECK_EQ(book.get_order_count(), size_t(3));
+    CHECK_EQ(book.get_ask_level_count(), size_t(3));
+    CHECK_EQ(book.get_best_ask(), Price(10000));
+    CHECK_EQ(book.get_trade_journal().last_sequence(), TradeSeq(0));
+
+    // No ID was used up either
+    OrderResult next = book.add_order(9000, 1, Side::BUY, TimeInForce::GTC, TradeCollector{&trades});
+    CHECK_EQ(next.order_id, OrderId(4));
+}
+
+TEST(fok_fills_completely_across_levels) {
+    OrderBook book;
+    seed_asks(book);
+    std::vector<Trade> trades;
+    OrderResult result = book.add_order(10200, 15, Side::BUY, TimeInForce::FOK, TradeCollector{&trades});
+    CHECK_EQ(result.status, OrderStatus::FILLED);
+    CHECK_EQ(result.filled_quantity, Quantity(15));
+    CHECK_EQ(trades.size(), size_t(3));
+    CHECK_EQ(book.get_order_count(), size_t(0));
+}
+
+TEST(ioc_cancels_its_remainder) {
+    OrderBook book;
+    seed_asks(book);
+    std::vector<Trade> trades;
+    OrderResult result = book.add_order(10100, 12, Side::BUY, TimeInForce::IOC, TradeCollector{&trades});
+    CHECK_EQ(result.status, OrderStatus::CANCELLED);
+    CHECK_EQ(result.filled_quantity, Quantity(10));
+    CHECK_EQ(result.resting_quantity, Quantity(0));
+    CHECK_EQ(trades.size(), size_t(2));
+
+    // Nothing rests on the bid side and the taker is not in the book
+    CHECK_EQ(book.get_bid_level_count(), size_t(0));
+    CHECK_EQ(book.get_order_count(), size_t(1));
+    CHECK(!book.cancel_order(result.order_id));
+}
+
+TEST(ioc_with_nothing_to_match) {
+    OrderBook book;
+    seed_asks(book);
+    std::vector<Trade> trades;
+    OrderResult result = book.add_order(9900, 4, Side::BUY, TimeInForce::IOC, TradeCollector{&trades});
+    CHECK_EQ(result.status, OrderStatus::CANCELLED);
+    CHECK_EQ(result.filled_quantity, Quantity(0));
+    CHECK(trades.empty());
+    CHECK_EQ(book.get_best_bid(), Price(0));
+}
+
+TEST(ioc_and_fok_need_no_ladder_slot) {
+    OrderBook book(1, 4096);
+    seed_asks(book);
+    std::vector<Trade> trades;
+    Price far = 10000 + 100000;
+
+    OrderResult ioc = book.add_order(far, 7, Side::BUY, TimeInForce::IOC, TradeCollector{&trades});
+    CHECK_EQ(ioc.status, OrderStatus::FILLED);
+    OrderResult fok = book.add_order(far, 100, Side::BUY, TimeInForce::FOK, TradeCollector{&trades});
+    CHECK_EQ(fok.status, OrderStatus::REJECTED);
+
+    // A GTC order there would have to rest, so it is still refused
+    CHECK_THROWS_AS(book.add_order(far, 1, Side::SELL, TimeInForce::GTC, TradeCollector{&trades}), std::out_of_range);
+    std::vector<OrderResult> results = book.add_orders(
+        {OrderRequest{far, 1, Side::BUY, OrderType::LIMIT, TimeInForce::IOC, OrderBook::kUnprotected},
+         OrderRequest{far, 1, Side::SELL, OrderType::LIMIT, TimeInForce::GTC, OrderBook::kUnprotected}}, trades);
+    CHECK_EQ(results[0].status, OrderStatus::FILLED);
+    CHECK_EQ(results[1].status, OrderStatus::REJECTED);
+}
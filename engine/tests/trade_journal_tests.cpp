@@ -0,0 +1,120 @@
+#include <string>
+#include <vector>
+#include <csignal>
+#include <unistd.h>
+#include <sys/resource.h>
+#include "test.hpp"
+#include "../include/trade_journal.hpp"
+
+using namespace trading;
+
+namespace {
+
+// Each trade's quantity is its sequence, so a record read back shows where
+// it came from
+void append_trades(TradeJournal& journal, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        Trade trade(1, 2, 10000, static_cast<Quantity>(journal.next_sequence()));
+        journal.append(trade);
+    }
+}
+
+bool dense_from(const std::vector<TradeRecord>& records, TradeSeq first) {
+    for (size_t i = 0; i < records.size(); ++i) {
+        if (records[i].sequence != first + i || records[i].trade.quantity != first + i) return false;
+    }
+    return true;
+}
+
+std::string temp_path(const char* name) {
+    return "/tmp/lob_tests_" + std::to_string(getpid()) + "_" + name;
+}
+
+}
+
+TEST(trade_journal_ring_keeps_the_latest) {
+    TradeJournal journal(16);
+    CHECK(journal.since(1).empty());
+    append_trades(journal, 40);
+
+    CHECK_EQ(journal.last_sequence(), TradeSeq(40));
+    CHECK_EQ(journal.first_available(), TradeSeq(25));
+    std::vector<TradeRecord> all = journal.since(1);
+    CHECK_EQ(all.size(), size_t(16));
+    CHECK(dense_from(all, 25));
+
+    std::vector<TradeRecord> tail = journal.last(5);
+    CHECK_EQ(tail.size(), size_t(5));
+    CHECK(dense_from(tail, 36));
+
+    std::vector<TradeRecord> page = journal.since(30, 3);
+    CHECK_EQ(page.size(), size_t(3));
+    CHECK(dense_from(page, 30));
+    CHECK(journal.since(41).empty());
+}
+
+TEST(trade_journal_reads_back_spilled_records) {
+    std::string path = temp_path("spill");
+    {
+        TradeJournal journal(16);
+        REQUIRE(journal.open_spill_file(path));
+        // Past one mapped window, so older records come back through pread
+        size_t count = TradeJournal::kSpillWindowRecords + 1000;
+        append_trades(journal, count);
+
+        CHECK_EQ(journal.first_available(), TradeSeq(1));
+        std::vector<TradeRecord> all = journal.since(1);
+        CHECK_EQ(all.size(), count);
+        CHECK(dense_from(all, 1));
+
+        TradeSeq edge = TradeJournal::kSpillWindowRecords - 2;
+        std::vector<TradeRecord> across = journal.since(edge, 5);
+        CHECK_EQ(across.size(), size_t(5));
+        CHECK(dense_from(across, edge));
+
+        std::vector<TradeRecord> tail = journal.last(40);
+        CHECK_EQ(tail.size(), size_t(40));
+        CHECK(dense_from(tail, count - 39));
+    }
+    unlink(path.c_str());
+}
+
+TEST(trade_journal_refuses_a_late_spill_file) {
+    std::string path = temp_path("late");
+    // A full ring has lost nothing yet
+    TradeJournal journal(16);
+    append_trades(journal, 16);
+    CHECK(journal.open_spill_file(path));
+
+    TradeJournal dropped(16);
+    append_trades(dropped, 17);
+    CHECK(!dropped.open_spill_file(path));
+    unlink(path.c_str());
+}
+
+TEST(trade_journal_falls_back_to_the_ring_when_the_file_cannot_grow) {
+    std::string path = temp_path("full");
+    rlimit saved;
+    getrlimit(RLIMIT_FSIZE, &saved);
+    auto saved_handler = signal(SIGXFSZ, SIG_IGN);
+
+    // Room for the first window only, so mapping the second one fails
+    rlimit limit = saved;
+    limit.rlim_cur = TradeJournal::kSpillWindowRecords * sizeof(TradeRecord) + 100;
+    setrlimit(RLIMIT_FSIZE, &limit);
+    {
+        TradeJournal journal(16);
+        REQUIRE(journal.open_spill_file(path));
+        append_trades(journal, TradeJournal::kSpillWindowRecords + 100);
+
+        // History is what the ring holds, with no gap before it
+        TradeSeq ring_first = journal.last_sequence() - 15;
+        CHECK_EQ(journal.first_available(), ring_first);
+        std::vector<TradeRecord> all = journal.since(1);
+        CHECK_EQ(all.size(), size_t(16));
+        CHECK(dense_from(all, ring_first));
+    }
+    setrlimit(RLIMIT_FSIZE, &saved);
+    signal(SIGXFSZ, saved_handler);
+    unlink(path.c_str());
+}